@@ -26,6 +26,15 @@
 // a slight runtime overhead.
 #define SALT_MEMORY_TEMPORARY_STACK_MODE (2)
 
+// The default sampling rate of the `Sampled_guarded_allocator`: on average every N-th allocation is
+// served from a guard-page protected slot, 0 disables the sampling. Unlike the debug checks it stays
+// enabled in release builds.
+#define SALT_MEMORY_GUARDED_SAMPLE_RATE (5000)
+
+// The number of guard-page protected slots of the `Sampled_guarded_allocator`, every slot occupies
+// one page plus one guard page of address space.
+#define SALT_MEMORY_GUARDED_SLOT_COUNT (256)
+
 #ifdef NDEBUG
 #    undef SALT_MEMORY_CHECK_ALLOCATION_SIZE
 #    define SALT_MEMORY_CHECK_ALLOCATION_SIZE (0)
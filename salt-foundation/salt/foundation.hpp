@@ -6,4 +6,7 @@
 #include <salt/foundation/uninitialized_storage.hpp>
 #include <salt/foundation/static_storage.hpp>
 #include <salt/foundation/slot_map.hpp>
+#include <salt/foundation/multi_slot_map.hpp>
+#include <salt/foundation/tracked_slot_map.hpp>
+#include <salt/foundation/parallel.hpp>
 // clang-format on
\ No newline at end of file
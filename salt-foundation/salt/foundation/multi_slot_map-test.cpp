@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+
+#include <salt/foundation.hpp>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+struct Position {
+    float x, y;
+};
+
+using Multi_slot_map = salt::Multi_slot_map<Position, float, std::string>;
+
+TEST_CASE("salt::Multi_slot_map", "[salt-utils/multi_slot_map.hpp]") {
+    SECTION("test if empty") {
+        Multi_slot_map map;
+        REQUIRE(map.empty());
+        REQUIRE(map.begin() == map.end());
+        REQUIRE(map.column<1>().empty());
+    }
+
+    SECTION("test insert") {
+        Multi_slot_map map;
+        auto           k = map.insert({1.f, 2.f}, 3.f, "a");
+        REQUIRE(map.size() == 1u);
+        REQUIRE(map.contains(k));
+        REQUIRE(map.get<0>(k).y == 2.f);
+        REQUIRE(map.get<1>(k) == 3.f);
+        REQUIRE(map.get<2>(k) == "a");
+    }
+
+    SECTION("test erase keeps the columns in step") {
+        Multi_slot_map                        map;
+        std::vector<Multi_slot_map::key_type> keys;
+        for (int i = 0; i < 8; i++) {
+            keys.push_back(map.emplace(Position{float(i), 0.f}, float(i), std::to_string(i)));
+        }
+        map.erase(keys[1]);
+        map.erase(keys[5]);
+        REQUIRE(map.size() == 6u);
+        REQUIRE_FALSE(map.contains(keys[1]));
+        REQUIRE(map.find(keys[5]) == map.end());
+
+        for (auto [key, position, value, name] : map) {
+            REQUIRE(position.x == value);
+            REQUIRE(name == std::to_string(int(value)));
+            REQUIRE(map.get<1>(key) == value);
+        }
+        for (std::size_t i = 0; i < map.size(); i++) {
+            REQUIRE(map.column<0>()[i].x == map.column<1>()[i]);
+            REQUIRE(map.get<1>(map.keys()[i]) == map.column<1>()[i]);
+        }
+    }
+
+    SECTION("test erase all iterator") {
+        Multi_slot_map map;
+        for (int i = 0; i < 5; i++) {
+            [[maybe_unused]] auto k = map.insert({}, float(i), {});
+        }
+        for (auto it = map.begin(); it != map.end();) {
+            it = map.erase(it);
+        }
+        REQUIRE(map.empty());
+        REQUIRE(map.column<2>().empty());
+    }
+
+    SECTION("test find") {
+        Multi_slot_map map;
+        auto           k  = map.insert({}, 42.f, "x");
+        auto           it = map.find(k);
+        REQUIRE(it != map.end());
+        REQUIRE(std::get<0>(*it) == k);
+        REQUIRE(std::get<2>(*it) == 42.f);
+
+        std::get<2>(*it) = 7.f;
+        REQUIRE(map.get<1>(k) == 7.f);
+    }
+
+    SECTION("test column") {
+        Multi_slot_map map;
+        map.reserve(16);
+        for (int i = 0; i < 16; i++) {
+            [[maybe_unused]] auto k = map.insert({}, float(i), {});
+        }
+        auto column = map.column<1>();
+        REQUIRE(column.size() == 16u);
+        REQUIRE(std::accumulate(column.begin(), column.end(), 0.f) == 120.f);
+    }
+
+    SECTION("test clear") {
+        Multi_slot_map map;
+        auto           k = map.insert({}, 1.f, "a");
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE_FALSE(map.contains(k));
+        REQUIRE(map.column<2>().empty());
+    }
+}
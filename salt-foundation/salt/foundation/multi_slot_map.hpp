@@ -0,0 +1,183 @@
+#pragma once
+#include <salt/foundation/slot_map.hpp>
+#include <salt/foundation/zip_iterator.hpp>
+
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace salt {
+
+// A Slot_map that stores an element as one column per type instead of a whole object, e.g. the
+// position and the velocity of an entity in two arrays. A loop that touches only some columns
+// streams only their memory, and each column is a contiguous std::span that can be processed with
+// SIMD. The keys and the first column are kept by a Slot_map, the other columns follow its
+// swap-and-pop erase, so the n-th element of each column belongs to the n-th key.
+// clang-format off
+template <typename T, typename... Ts>
+    requires (std::is_nothrow_move_constructible_v<Ts> and ...) and
+             (std::is_nothrow_move_assignable_v<Ts>    and ...)
+// clang-format on
+class [[nodiscard]] Multi_slot_map {
+    using slot_map         = Slot_map<T>;
+    using column_container = std::tuple<std::vector<Ts>...>;
+    using key_iterator =
+            std::ranges::iterator_t<decltype(std::declval<slot_map const&>().keys())>;
+
+public:
+    using key_type        = typename slot_map::key_type;
+    using size_type       = typename slot_map::size_type;
+    using value_type      = std::tuple<T, Ts...>;
+    using iterator        = Multi_zip_iterator<key_iterator, T*, Ts*...>;
+    using const_iterator  = Multi_zip_iterator<key_iterator, T const*, Ts const*...>;
+    using difference_type = typename iterator::difference_type;
+
+    static constexpr std::size_t column_count = 1u + sizeof...(Ts);
+
+    template <std::size_t I> using column_type = std::tuple_element_t<I, value_type>;
+
+    // clang-format off
+    static constexpr size_type max_size() noexcept { return slot_map::max_size(); }
+
+    constexpr iterator       begin()       noexcept { return at(0u);      }
+    constexpr iterator       end()         noexcept { return at(size());  }
+    constexpr const_iterator begin() const noexcept { return at(0u);      }
+    constexpr const_iterator end()   const noexcept { return at(size());  }
+
+    constexpr size_type size()  const noexcept { return slot_map_.size();  }
+    constexpr bool      empty() const noexcept { return slot_map_.empty(); }
+    // clang-format on
+
+    constexpr void clear() noexcept {
+        slot_map_.clear();
+        std::apply([](auto&... columns) { (columns.clear(), ...); }, columns_);
+    }
+
+    constexpr void reserve(size_type size) {
+        slot_map_.reserve(size);
+        std::apply([size](auto&... columns) { (columns.reserve(size), ...); }, columns_);
+    }
+
+    // Constructs each column of the new element from one of the arguments.
+    // clang-format off
+    template <typename Arg, typename... Args> requires (sizeof...(Args) == sizeof...(Ts))
+    [[nodiscard]] constexpr key_type emplace(Arg&& arg, Args&&... args) {
+        auto const key = slot_map_.emplace(std::forward<Arg>(arg)).key;
+        try {
+            emplace_columns(std::index_sequence_for<Ts...>{}, std::forward<Args>(args)...);
+        } catch (...) {
+            slot_map_.erase(key);
+            throw;
+        }
+        return key;
+    }
+    // clang-format on
+
+    [[nodiscard]] constexpr key_type insert(T value, Ts... values) {
+        return emplace(std::move(value), std::move(values)...);
+    }
+
+    constexpr void erase(key_type key) noexcept {
+        erase_at(index(key));
+    }
+
+    constexpr iterator erase(iterator it) noexcept {
+        auto const idx = static_cast<size_type>(it - begin());
+        erase_at(idx);
+        return at(idx);
+    }
+
+    constexpr iterator find(key_type key) noexcept {
+        auto const it = slot_map_.find(key);
+        return it == slot_map_.end() ? end() : begin() + (it - slot_map_.begin());
+    }
+
+    constexpr const_iterator find(key_type key) const noexcept {
+        auto const it = slot_map_.find(key);
+        return it == slot_map_.end() ? end() : begin() + (it - slot_map_.begin());
+    }
+
+    constexpr bool contains(key_type key) const noexcept {
+        return slot_map_.contains(key);
+    }
+
+    // Returns the element of the key in the I-th column.
+    template <std::size_t I> constexpr column_type<I>& get(key_type key) noexcept {
+        return column<I>()[index(key)];
+    }
+
+    template <std::size_t I> constexpr column_type<I> const& get(key_type key) const noexcept {
+        return column<I>()[index(key)];
+    }
+
+    // Returns the I-th column, ordered like the keys.
+    template <std::size_t I> constexpr std::span<column_type<I>> column() noexcept {
+        if constexpr (I == 0u)
+            return {slot_map_.data(), slot_map_.size()};
+        else
+            return std::get<I - 1u>(columns_);
+    }
+
+    template <std::size_t I> constexpr std::span<column_type<I> const> column() const noexcept {
+        if constexpr (I == 0u)
+            return {slot_map_.data(), slot_map_.size()};
+        else
+            return std::get<I - 1u>(columns_);
+    }
+
+    constexpr std::span<key_type const> keys() const noexcept {
+        return {slot_map_.keys().begin(), slot_map_.keys().end()};
+    }
+
+private:
+    constexpr size_type index(key_type key) const noexcept {
+        return static_cast<size_type>(slot_map_.access(key) - slot_map_.begin());
+    }
+
+    constexpr iterator at(size_type idx) noexcept {
+        return at(idx, std::make_index_sequence<column_count>{});
+    }
+
+    constexpr const_iterator at(size_type idx) const noexcept {
+        return at(idx, std::make_index_sequence<column_count>{});
+    }
+
+    template <std::size_t... Is>
+    constexpr iterator at(size_type idx, std::index_sequence<Is...>) noexcept {
+        auto const d = static_cast<difference_type>(idx);
+        return iterator{slot_map_.keys().begin() + d, (column<Is>().data() + d)...};
+    }
+
+    template <std::size_t... Is>
+    constexpr const_iterator at(size_type idx, std::index_sequence<Is...>) const noexcept {
+        auto const d = static_cast<difference_type>(idx);
+        return const_iterator{slot_map_.keys().begin() + d, (column<Is>().data() + d)...};
+    }
+
+    // Emplaces into the other columns, the ones already emplaced are popped if one throws.
+    template <std::size_t... Is, typename... Args>
+    constexpr void emplace_columns(std::index_sequence<Is...>, Args&&... args) {
+        [[maybe_unused]] std::size_t emplaced = 0u;
+        try {
+            ((std::get<Is>(columns_).emplace_back(std::forward<Args>(args)), ++emplaced), ...);
+        } catch (...) {
+            ((Is < emplaced ? std::get<Is>(columns_).pop_back() : void()), ...);
+            throw;
+        }
+    }
+
+    constexpr void erase_at(size_type idx) noexcept {
+        (void)slot_map_.erase(slot_map_.begin() + static_cast<difference_type>(idx));
+        std::apply(
+                [idx](auto&... columns) {
+                    ((std::ranges::swap(columns[idx], columns.back()), columns.pop_back()), ...);
+                },
+                columns_);
+    }
+
+    slot_map         slot_map_;
+    column_container columns_;
+};
+
+} // namespace salt
@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include <salt/foundation.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("salt::Thread_pool", "[salt-foundation/parallel.hpp]") {
+    salt::Thread_pool pool{4u};
+    REQUIRE(pool.thread_count() == 4u);
+
+    SECTION("test run calls each task once") {
+        std::vector<std::atomic<int>> calls(1000u);
+        pool.run(calls.size(), [&](std::size_t i) { ++calls[i]; });
+        REQUIRE(std::ranges::all_of(calls, [](auto const& c) { return c.load() == 1; }));
+    }
+
+    SECTION("test run rethrows") {
+        REQUIRE_THROWS_AS(pool.run(100u,
+                                   [](std::size_t i) {
+                                       if (i == 42u)
+                                           throw std::runtime_error{"task"};
+                                   }),
+                          std::runtime_error);
+
+        std::atomic<std::size_t> count = 0u;
+        pool.run(100u, [&](std::size_t) { ++count; });
+        REQUIRE(count == 100u);
+    }
+
+    SECTION("test nested run") {
+        std::atomic<std::size_t> count = 0u;
+        pool.run(8u, [&](std::size_t) { pool.run(8u, [&](std::size_t) { ++count; }); });
+        REQUIRE(count == 64u);
+    }
+}
+
+TEST_CASE("salt::parallel_for_each", "[salt-foundation/parallel.hpp]") {
+    salt::Thread_pool           pool{4u};
+    salt::Parallel_stats        stats;
+    salt::Parallel_policy const policy{.pool = &pool, .min_chunk_size = 64u, .stats = &stats};
+
+    SECTION("test chunks are cache-line aligned") {
+        std::vector<std::uint32_t> values(10000u);
+        auto const chunks = salt::detail::make_parallel_chunks(values, 64u, 4u);
+        REQUIRE(chunks.begin(0u) == 0u);
+        REQUIRE(chunks.end(chunks.count() - 1u) == values.size());
+        for (std::size_t i = 1u; i < chunks.count(); ++i) {
+            auto const address = reinterpret_cast<std::uintptr_t>(&values[chunks.begin(i)]);
+            REQUIRE(address % salt::parallel_chunk_alignment == 0u);
+            REQUIRE(chunks.begin(i) == chunks.end(i - 1u));
+        }
+
+        auto const unaligned = std::span{values}.subspan(3u);
+        auto const shifted   = salt::detail::make_parallel_chunks(unaligned, 64u, 4u);
+        REQUIRE(shifted.end(shifted.count() - 1u) == unaligned.size());
+        auto const address = reinterpret_cast<std::uintptr_t>(&unaligned[shifted.begin(1u)]);
+        REQUIRE(address % salt::parallel_chunk_alignment == 0u);
+    }
+
+    SECTION("test span") {
+        std::vector<int> values(10000u);
+        std::iota(values.begin(), values.end(), 0);
+        salt::parallel_for_each(policy, std::span{values}, [](int& value) { value *= 2; });
+        for (std::size_t i = 0u; i < values.size(); ++i)
+            REQUIRE(values[i] == int(i) * 2);
+
+        REQUIRE(stats.element_count == values.size());
+        REQUIRE(stats.chunk_count > 1u);
+        REQUIRE(stats.thread_count == 4u);
+        REQUIRE(stats.min_chunk_time <= stats.max_chunk_time);
+        REQUIRE(stats.max_chunk_time <= stats.total_chunk_time);
+        REQUIRE(stats.throughput() >= 0.0);
+    }
+
+    SECTION("test slot map") {
+        salt::Slot_map<int> map;
+        for (int i = 0; i < 5000; ++i)
+            (void)map.insert(i);
+
+        salt::parallel_for_each(policy, map.values(), [](int& value) { ++value; });
+        REQUIRE(map.values()[0u] == 1);
+        REQUIRE(map.values()[map.size() - 1u] == 5000);
+
+        std::atomic<std::size_t> found = 0u;
+        salt::parallel_for_each(policy, map, [&](auto const& pair) {
+            if (map.contains(pair.first))
+                ++found;
+        });
+        REQUIRE(found == map.size());
+    }
+
+    SECTION("test empty range") {
+        std::vector<int> values;
+        salt::parallel_for_each(policy, values, [](int&) { FAIL(); });
+        REQUIRE(stats.element_count == 0u);
+        REQUIRE(stats.chunk_count == 0u);
+    }
+}
+
+TEST_CASE("salt::parallel_transform_reduce", "[salt-foundation/parallel.hpp]") {
+    salt::Thread_pool pool{4u};
+
+    std::vector<std::uint64_t> values(100000u);
+    std::iota(values.begin(), values.end(), std::uint64_t{1});
+
+    auto const square = [](std::uint64_t value) { return value * value; };
+    auto const expected = std::transform_reduce(values.begin(), values.end(), std::uint64_t{7},
+                                                std::plus{}, square);
+
+    salt::Parallel_stats stats;
+    REQUIRE(salt::parallel_transform_reduce({.pool = &pool, .stats = &stats}, values,
+                                            std::uint64_t{7}, std::plus{}, square) == expected);
+    REQUIRE(stats.chunk_count > 1u);
+
+    // The chunks are reduced in order, so a non-commutative reduction keeps the order.
+    std::vector<std::string> words(3000u, "a");
+    words.back() = "b";
+    auto const joined = salt::parallel_transform_reduce(
+            {.pool = &pool, .min_chunk_size = 16u}, words, std::string{"<"}, std::plus{},
+            [](std::string const& word) { return word; });
+    REQUIRE(joined.size() == 3001u);
+    REQUIRE(joined.front() == '<');
+    REQUIRE(joined.back() == 'b');
+
+    REQUIRE(salt::parallel_transform_reduce(std::vector<int>{}, 3, std::plus{},
+                                            [](int value) { return value; }) == 3);
+}
@@ -0,0 +1,351 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace salt {
+
+// The boundary the chunks of a contiguous range are aligned to, so two threads never write to the
+// same cache line.
+static constexpr inline std::size_t parallel_chunk_alignment = 64u;
+
+// A fixed set of worker threads that run the chunks of the parallel algorithms. The thread that
+// calls `run` works on the chunks as well.
+// NOTE:
+//  * One `run` is executed at a time, the calls of other threads wait for it.
+//  * A `run` inside of a task is executed by the calling thread alone, so nesting never deadlocks.
+class [[nodiscard]] Thread_pool final {
+public:
+    // Creates `thread_count - 1` workers, the calling thread is the last one.
+    explicit Thread_pool(std::size_t thread_count = std::thread::hardware_concurrency()) {
+        for (std::size_t i = 1u; i < thread_count; ++i)
+            workers_.emplace_back([this](std::stop_token stop) { work(stop); });
+    }
+
+    Thread_pool(Thread_pool const&)            = delete;
+    Thread_pool& operator=(Thread_pool const&) = delete;
+
+    // The pool used when no other one is given, it has a thread per hardware thread.
+    static Thread_pool& global() {
+        static Thread_pool pool;
+        return pool;
+    }
+
+    // The number of threads that run the tasks, including the calling one.
+    std::size_t thread_count() const noexcept {
+        return workers_.size() + 1u;
+    }
+
+    // Calls `task(i)` for each i in [0, count) and returns when all calls have returned. If a task
+    // throws, the tasks that didn't start yet are skipped and the first exception is rethrown.
+    template <typename Task> void run(std::size_t count, Task const& task) {
+        if (count <= 1u or workers_.empty() or current() != nullptr) {
+            for (std::size_t i = 0u; i != count; ++i)
+                task(i);
+            return;
+        }
+
+        std::lock_guard run_lock{run_mutex_};
+        Job             job{[](void const* t, std::size_t i) { (*static_cast<Task const*>(t))(i); },
+                std::addressof(task), count};
+        {
+            std::lock_guard lock{mutex_};
+            job_ = &job;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        current() = this;
+        execute(job);
+        current() = nullptr;
+
+        {
+            std::unique_lock lock{mutex_};
+            job_ = nullptr;
+            done_.wait(lock, [this] { return busy_ == 0u; });
+        }
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+private:
+    struct [[nodiscard]] Job final {
+        Job(void (*job_invoke)(void const*, std::size_t), void const* job_task,
+            std::size_t job_count) noexcept
+                : invoke{job_invoke}, task{job_task}, count{job_count} {}
+
+        void (*invoke)(void const*, std::size_t);
+        void const*              task;
+        std::size_t              count;
+        std::atomic<std::size_t> next{0u};
+        std::mutex               error_mutex;
+        std::exception_ptr       error;
+    };
+
+    // The pool whose task the thread is running.
+    static Thread_pool const*& current() noexcept {
+        thread_local Thread_pool const* pool = nullptr;
+        return pool;
+    }
+
+    static void execute(Job& job) noexcept {
+        for (auto i = job.next.fetch_add(1u, std::memory_order_relaxed); i < job.count;
+             i      = job.next.fetch_add(1u, std::memory_order_relaxed)) {
+            try {
+                job.invoke(job.task, i);
+            } catch (...) {
+                job.next.store(job.count, std::memory_order_relaxed);
+                std::lock_guard lock{job.error_mutex};
+                if (not job.error)
+                    job.error = std::current_exception();
+            }
+        }
+    }
+
+    void work(std::stop_token stop) {
+        current() = this;
+
+        std::uint64_t    seen = 0u;
+        std::unique_lock lock{mutex_};
+        while (wake_.wait(lock, stop, [&] { return generation_ != seen; })) {
+            seen = generation_;
+            if (job_ == nullptr)
+                continue;
+
+            auto& job = *job_;
+            ++busy_;
+            lock.unlock();
+            execute(job);
+            lock.lock();
+            if (--busy_ == 0u)
+                done_.notify_all();
+        }
+    }
+
+    std::mutex                  run_mutex_;
+    std::mutex                  mutex_;
+    std::condition_variable_any wake_;
+    std::condition_variable     done_;
+    Job*                        job_        = nullptr;
+    std::uint64_t               generation_ = 0u;
+    std::size_t                 busy_       = 0u;
+    std::vector<std::jthread>   workers_;
+};
+
+// What a parallel algorithm achieved, the difference between the throughput of the whole call and
+// the one of a single chunk is the speedup from the threads.
+struct [[nodiscard]] Parallel_stats final {
+    std::size_t              element_count = 0u;
+    std::size_t              chunk_count   = 0u;
+    std::size_t              thread_count  = 0u;
+    std::chrono::nanoseconds elapsed{};
+    std::chrono::nanoseconds min_chunk_time{};
+    std::chrono::nanoseconds max_chunk_time{};
+    std::chrono::nanoseconds total_chunk_time{};
+
+    // Elements per second of the whole call.
+    double throughput() const noexcept {
+        return per_second(element_count, elapsed);
+    }
+
+    // Elements per second of one chunk, on average.
+    double chunk_throughput() const noexcept {
+        return per_second(element_count, total_chunk_time);
+    }
+
+private:
+    static double per_second(std::size_t count, std::chrono::nanoseconds time) noexcept {
+        return time.count() > 0 ? double(count) * 1e9 / double(time.count()) : 0.0;
+    }
+};
+
+// Controls how a parallel algorithm splits its range, like an execution policy.
+struct [[nodiscard]] Parallel_policy final {
+    // The pool that runs the chunks, the global one if null.
+    Thread_pool* pool = nullptr;
+    // The smallest number of elements of a chunk.
+    std::size_t min_chunk_size = 1024u;
+    // Receives the stats of the call if not null, it costs two clock reads per chunk.
+    Parallel_stats* stats = nullptr;
+};
+
+// The default policy, like std::execution::par_unseq the element function must not synchronize
+// with other calls.
+inline constexpr Parallel_policy par_unseq{};
+
+namespace detail {
+
+// Splits a range of `size` elements of `element_size` bytes into chunks, their boundaries are at
+// multiples of `parallel_chunk_alignment` if the first element is at `address`.
+struct [[nodiscard]] Parallel_chunks final {
+    Parallel_chunks(std::size_t size, std::size_t element_size, void const* address,
+                    std::size_t min_chunk_size, std::size_t thread_count) noexcept
+            : size_{size} {
+        auto const line_elements = parallel_chunk_alignment /
+                                   std::gcd(parallel_chunk_alignment, element_size);
+        // A few chunks per thread balance the load when some chunks take longer.
+        auto const target = std::max((size + thread_count * 4u - 1u) / (thread_count * 4u),
+                                     std::max(min_chunk_size, std::size_t{1}));
+        chunk_size_ = (target + line_elements - 1u) / line_elements * line_elements;
+
+        if (address != nullptr) {
+            auto const misalignment = reinterpret_cast<std::uintptr_t>(address) %
+                                      parallel_chunk_alignment;
+            for (std::size_t k = 0u; k != line_elements; ++k)
+                if ((misalignment + k * element_size) % parallel_chunk_alignment == 0u) {
+                    offset_ = k;
+                    break;
+                }
+        }
+        // The elements before the first boundary are a chunk of their own.
+        offset_ = std::min(offset_, size_);
+        head_   = offset_ != 0u ? 1u : 0u;
+        count_  = offset_ == size_ ? std::min(size_, std::size_t{1})
+                                   : head_ + (size_ - offset_ + chunk_size_ - 1u) / chunk_size_;
+    }
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    std::size_t count() const noexcept {
+        return count_;
+    }
+
+    std::size_t begin(std::size_t chunk) const noexcept {
+        if (chunk == 0u)
+            return 0u;
+        return std::min(size_, offset_ + (chunk - head_) * chunk_size_);
+    }
+
+    std::size_t end(std::size_t chunk) const noexcept {
+        return begin(chunk + 1u);
+    }
+
+private:
+    std::size_t size_;
+    std::size_t chunk_size_ = 1u;
+    std::size_t offset_     = 0u;
+    std::size_t head_       = 0u;
+    std::size_t count_      = 0u;
+};
+
+template <std::ranges::random_access_range R>
+Parallel_chunks make_parallel_chunks(R& range, std::size_t min_chunk_size,
+                                     std::size_t thread_count) noexcept {
+    void const* data = nullptr;
+    if constexpr (std::ranges::contiguous_range<R>)
+        data = std::ranges::data(range);
+    return {static_cast<std::size_t>(std::ranges::distance(range)),
+            sizeof(std::ranges::range_value_t<R>), data, min_chunk_size, thread_count};
+}
+
+inline Thread_pool& parallel_pool(Parallel_policy const& policy) {
+    return policy.pool ? *policy.pool : Thread_pool::global();
+}
+
+// Runs `process(chunk, first, last)` for each chunk of the range on the pool and fills the stats of
+// the policy.
+template <std::ranges::random_access_range R, typename Process>
+void run_parallel_chunks(Parallel_policy const& policy, Thread_pool& pool,
+                         Parallel_chunks const& chunks, R& range, Process const& process) {
+    using clock      = std::chrono::steady_clock;
+    using difference = std::ranges::range_difference_t<R>;
+
+    auto const first = std::ranges::begin(range);
+    std::vector<std::chrono::nanoseconds> times(policy.stats ? chunks.count() : 0u);
+
+    auto const start = clock::now();
+    pool.run(chunks.count(), [&](std::size_t chunk) {
+        auto const chunk_start = policy.stats ? clock::now() : clock::time_point{};
+        process(chunk, first + difference(chunks.begin(chunk)),
+                first + difference(chunks.end(chunk)));
+        if (policy.stats)
+            times[chunk] = clock::now() - chunk_start;
+    });
+
+    if (auto const stats = policy.stats) {
+        stats->element_count    = chunks.size();
+        stats->chunk_count      = chunks.count();
+        stats->thread_count     = pool.thread_count();
+        stats->elapsed          = clock::now() - start;
+        stats->min_chunk_time   = times.empty() ? decltype(times)::value_type{}
+                                                : std::ranges::min(times);
+        stats->max_chunk_time   = times.empty() ? decltype(times)::value_type{}
+                                                : std::ranges::max(times);
+        stats->total_chunk_time = std::reduce(times.begin(), times.end());
+    }
+}
+
+} // namespace detail
+
+// Calls `function` for each element of a random access range, e.g. a Slot_map, its values() or a
+// span, with the range split into chunks that run on a Thread_pool.
+// clang-format off
+template <std::ranges::random_access_range R, typename Function>
+    requires std::invocable<Function&, std::ranges::range_reference_t<R>>
+void parallel_for_each(Parallel_policy const& policy, R&& range, Function function) {
+    auto&      pool   = detail::parallel_pool(policy);
+    auto const chunks = detail::make_parallel_chunks(range, policy.min_chunk_size,
+                                                     pool.thread_count());
+    detail::run_parallel_chunks(policy, pool, chunks, range,
+                                [&function](std::size_t, auto first, auto last) {
+                                    for (; first != last; ++first)
+                                        std::invoke(function, *first);
+                                });
+}
+
+template <std::ranges::random_access_range R, typename Function>
+    requires std::invocable<Function&, std::ranges::range_reference_t<R>>
+void parallel_for_each(R&& range, Function function) {
+    parallel_for_each(par_unseq, std::forward<R>(range), std::move(function));
+}
+
+// Reduces the transformed elements, each chunk is reduced on its own and the results of the
+// chunks are reduced in their order, so `reduce` has to be associative.
+template <std::ranges::random_access_range R, typename T, typename Reduce, typename Transform>
+    requires std::invocable<Transform&, std::ranges::range_reference_t<R>>
+T parallel_transform_reduce(Parallel_policy const& policy, R&& range, T init, Reduce reduce,
+                            Transform transform) {
+    auto&      pool   = detail::parallel_pool(policy);
+    auto const chunks = detail::make_parallel_chunks(range, policy.min_chunk_size,
+                                                     pool.thread_count());
+
+    std::vector<std::optional<T>> partials(chunks.count());
+    auto const reduce_chunk = [&](std::size_t chunk, auto first, auto last) {
+        if (first == last)
+            return;
+        T result = std::invoke(transform, *first);
+        for (++first; first != last; ++first)
+            result = std::invoke(reduce, std::move(result), std::invoke(transform, *first));
+        partials[chunk].emplace(std::move(result));
+    };
+    detail::run_parallel_chunks(policy, pool, chunks, range, reduce_chunk);
+
+    for (auto& partial : partials)
+        if (partial)
+            init = std::invoke(reduce, std::move(init), std::move(*partial));
+    return init;
+}
+
+template <std::ranges::random_access_range R, typename T, typename Reduce, typename Transform>
+    requires std::invocable<Transform&, std::ranges::range_reference_t<R>>
+T parallel_transform_reduce(R&& range, T init, Reduce reduce, Transform transform) {
+    return parallel_transform_reduce(par_unseq, std::forward<R>(range), std::move(init),
+                                     std::move(reduce), std::move(transform));
+}
+// clang-format on
+
+} // namespace salt
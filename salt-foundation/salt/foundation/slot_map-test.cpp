@@ -409,4 +409,235 @@ TEST_CASE("salt::Slot_map", "[salt-utils/slot_map.hpp]") {
         REQUIRE(salt::ranges::is_permutation(map.values(), values));
 #endif
     }
-}
\ No newline at end of file
+}
+
+template <typename T>
+using Generational_slot_map = salt::Slot_map<T, std::uint32_t, Vector, Vector, 8u>;
+
+TEST_CASE("salt::Slot_map with generations", "[salt-utils/slot_map.hpp]") {
+    using key_type = Generational_slot_map<int>::key_type;
+    static_assert(sizeof(key_type) == sizeof(std::uint32_t));
+    static_assert(key_type::index_bits == 24u);
+
+    SECTION("test insert after erase") {
+        Generational_slot_map<int> map;
+
+        auto base_k = map.insert(0);
+        auto old_k  = map.insert(1);
+        map.erase(old_k);
+        auto new_k = map.insert(2);
+
+        REQUIRE(new_k.index() == old_k.index());
+        REQUIRE(new_k.generation() == old_k.generation() + 1u);
+        REQUIRE(map.find(old_k) == map.end());
+        REQUIRE_FALSE(map.contains(old_k));
+        REQUIRE(map[base_k] == 0);
+        REQUIRE(map[new_k] == 2);
+    }
+
+    SECTION("test erase moves the last key") {
+        Generational_slot_map<int> map;
+        std::vector<key_type>      keys;
+        for (int i = 0; i < 8; i++) {
+            keys.push_back(map.insert(i));
+        }
+        map.erase(keys[2]);
+        map.erase(keys[0]);
+
+        REQUIRE_FALSE(map.contains(keys[0]));
+        REQUIRE_FALSE(map.contains(keys[2]));
+        for (int i = 0; i < 8; i++) {
+            if (i != 0 and i != 2) {
+                REQUIRE(map[keys[std::size_t(i)]] == i);
+            }
+        }
+    }
+
+    SECTION("test find after clear") {
+        Generational_slot_map<int> map;
+        auto                       k = map.insert(0xffdead);
+        map.clear();
+        auto new_k = map.insert(0);
+
+        REQUIRE(new_k.index() == k.index());
+        REQUIRE(map.find(k) == map.end());
+        REQUIRE(map.find(new_k) != map.end());
+    }
+
+    SECTION("test generation wraps around") {
+        Generational_slot_map<int> map;
+        auto                       k = map.insert(0);
+        for (std::size_t i = 0; i < 255; i++) {
+            (void)map.erase(map.begin());
+            REQUIRE_FALSE(map.contains(k));
+            [[maybe_unused]] auto new_k = map.insert(int(i));
+        }
+        (void)map.erase(map.begin());
+        REQUIRE(map.insert(1) == k);
+    }
+
+    SECTION("test insert throws when the indices are exhausted") {
+        using small_map = salt::Slot_map<int, std::uint16_t, Vector, Vector, 8u>;
+        static_assert(small_map::max_size() == 254u);
+
+        small_map map;
+        for (std::size_t i = 0; i != small_map::max_size(); i++) {
+            auto const k = map.insert(int(i));
+            REQUIRE(k.index() < small_map::key_type::index_mask);
+        }
+        REQUIRE_THROWS_AS(map.insert(0), std::length_error);
+        REQUIRE(map.size() == small_map::max_size());
+
+        (void)map.erase(map.begin());
+        auto const k = map.insert(1);
+        REQUIRE(map[k] == 1);
+    }
+}
+
+TEST_CASE("salt::Slot_map bulk operations", "[salt-utils/slot_map.hpp]") {
+    using key_type = Generational_slot_map<int>::key_type;
+
+    SECTION("test insert_range and emplace_n") {
+        Generational_slot_map<int> map;
+        std::vector                values = {0, 1, 2, 3, 4};
+
+        auto const keys = map.insert_range(values);
+        REQUIRE(keys.size() == values.size());
+        for (std::size_t i = 0; auto k : keys) {
+            REQUIRE(map[k] == values[i++]);
+        }
+
+        auto const copies = map.emplace_n(3u, 7);
+        REQUIRE(copies.size() == 3u);
+        REQUIRE(map.size() == 8u);
+        for (auto k : copies) {
+            REQUIRE(map[k] == 7);
+        }
+        REQUIRE(map.emplace_n(0u, 1).empty());
+    }
+
+    SECTION("test erase_if keeps the order") {
+        Generational_slot_map<int> map;
+        std::vector<key_type>      keys;
+        for (int i = 0; i < 100; i++) {
+            keys.push_back(map.insert(i));
+        }
+
+        auto const erased = map.erase_if([](auto const& kv) { return kv.second % 3 != 0; });
+        REQUIRE(erased == 66u);
+        REQUIRE(map.size() == 34u);
+        REQUIRE(std::ranges::is_sorted(map.values()));
+        for (int i = 0; i < 100; i++) {
+            auto const k = keys[std::size_t(i)];
+            REQUIRE(map.contains(k) == (i % 3 == 0));
+            if (i % 3 == 0) {
+                REQUIRE(map[k] == i);
+            }
+        }
+
+        // The freed slots are reused with a new generation.
+        auto const new_k = map.insert(100);
+        REQUIRE(map[new_k] == 100);
+        REQUIRE_FALSE(map.contains(keys[new_k.index()]));
+    }
+
+    SECTION("test erase_if with a throwing predicate") {
+        Generational_slot_map<int> map;
+        std::vector<key_type>      keys;
+        for (int i = 0; i < 10; i++) {
+            keys.push_back(map.insert(i));
+        }
+
+        REQUIRE_THROWS(map.erase_if([](auto const& kv) {
+            if (kv.second == 5) {
+                throw std::runtime_error("erase_if");
+            }
+            return kv.second % 2 == 0;
+        }));
+        REQUIRE(map.size() == 7u);
+        for (int i = 0; i < 10; i++) {
+            auto const k = keys[std::size_t(i)];
+            REQUIRE(map.contains(k) == (i >= 5 or i % 2 != 0));
+            if (map.contains(k)) {
+                REQUIRE(map[k] == i);
+            }
+        }
+    }
+
+    SECTION("test erase a span of keys") {
+        Slot_map<int>                        map;
+        std::vector<decltype(map)::key_type> keys;
+        for (int i = 0; i < 16; i++) {
+            keys.push_back(map.insert(i));
+        }
+
+        std::vector<decltype(map)::key_type> erased;
+        std::vector<decltype(map)::key_type> kept;
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            (i % 4 == 1 ? erased : kept).push_back(keys[i]);
+        }
+        map.erase(erased);
+
+        REQUIRE(map.size() == kept.size());
+        REQUIRE(std::ranges::equal(map.keys(), kept));
+        for (auto k : kept) {
+            REQUIRE(map[k] == int(k.index()));
+        }
+        for (auto k : erased) {
+            REQUIRE_FALSE(map.contains(k));
+        }
+
+        map.erase(std::span{kept});
+        REQUIRE(map.empty());
+    }
+}
+
+TEST_CASE("salt::Slot_map reorder", "[salt-utils/slot_map.hpp]") {
+    using key_type = Generational_slot_map<int>::key_type;
+
+    Generational_slot_map<int> map;
+    std::vector<key_type>      keys;
+    for (int i = 0; i < 64; i++) {
+        keys.push_back(map.insert((i * 37) % 64));
+    }
+    for (int i = 0; i < 64; i += 5) {
+        map.erase(keys[std::size_t(i)]);
+    }
+
+    auto const require_keys_valid = [&] {
+        for (int i = 0; i < 64; i++) {
+            auto const k = keys[std::size_t(i)];
+            REQUIRE(map.contains(k) == (i % 5 != 0));
+            if (i % 5 != 0) {
+                REQUIRE(map[k] == (i * 37) % 64);
+                REQUIRE(map.find(k)->first == k);
+            }
+        }
+    };
+
+    SECTION("test sort") {
+        map.sort();
+        REQUIRE(std::ranges::is_sorted(map.values()));
+        require_keys_valid();
+
+        map.sort(std::ranges::greater{}, [](int v) { return v % 8; });
+        REQUIRE(std::ranges::is_sorted(map.values(), std::ranges::greater{},
+                                       [](int v) { return v % 8; }));
+        require_keys_valid();
+    }
+
+    SECTION("test reorder") {
+        std::vector<int> const values{map.values().begin(), map.values().end()};
+
+        std::vector<std::size_t> permutation(map.size());
+        for (std::size_t i = 0; i < permutation.size(); i++) {
+            permutation[i] = (i * 7u + 3u) % permutation.size();
+        }
+        map.reorder(permutation);
+
+        for (std::size_t i = 0; i < permutation.size(); i++) {
+            REQUIRE(map.values()[i] == values[permutation[i]]);
+        }
+        require_keys_valid();
+    }
+}
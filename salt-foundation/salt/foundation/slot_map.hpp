@@ -2,21 +2,30 @@
 #include <salt/foundation/slot_map_base.hpp>
 
 #include <algorithm>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 namespace salt {
 
 /// @see https://www.open-std.org/jtc1/sc22/wg21/docs/papers/2017/p0661r0.pdf
+// With GenerationBits the generation of each slot is stored next to its index in the index array,
+// so a key is validated by a single load and compare, and stale keys are not found anymore when
+// their slot is reused. Without them a key is validated against the key array.
 // clang-format off
 template <
     typename T,
     std::unsigned_integral KeyType                 = unsigned,
     template <typename...> typename ValueContainer = std::vector,
-    template <typename...> typename KeyContainer   = ValueContainer
+    template <typename...> typename KeyContainer   = ValueContainer,
+    std::size_t                     GenerationBits = 0u
 > requires slottable<T, KeyType, ValueContainer, KeyContainer>
 // clang-format on
-class [[nodiscard]] Slot_map : public Slot_map_base<T, KeyType, ValueContainer, KeyContainer> {
-    using base             = Slot_map_base<T, KeyType, ValueContainer, KeyContainer>;
+class [[nodiscard]] Slot_map
+        : public Slot_map_base<T, KeyType, ValueContainer, KeyContainer, GenerationBits> {
+    using base = Slot_map_base<T, KeyType, ValueContainer, KeyContainer, GenerationBits>;
     using const_key_view   = decltype(std::declval<base const*>()->keys());
     using const_value_view = decltype(std::declval<base const*>()->values());
     using value_view       = decltype(std::declval<base*>()->values());
@@ -24,7 +33,6 @@ class [[nodiscard]] Slot_map : public Slot_map_base<T, KeyType, ValueContainer,
     using base::indices_;
     using base::keys_;
     using base::values_;
-    using typename base::index_type;
 
     static_assert(std::ranges::borrowed_range<const_key_view>);
     static_assert(std::ranges::borrowed_range<const_value_view>);
@@ -37,12 +45,13 @@ class [[nodiscard]] Slot_map : public Slot_map_base<T, KeyType, ValueContainer,
     using const_value_iterator = std::ranges::iterator_t<const_value_view>;
     using value_iterator       = std::ranges::iterator_t<value_view>;
 
-    static constexpr index_type free_idx_null = std::numeric_limits<KeyType>::max();
-    index_type                  free_idx_     = free_idx_null;
-
 public:
+    using typename base::index_type;
+    using typename base::index_container;
+    using typename base::key_container;
     using typename base::key_type;
     using typename base::size_type;
+    using typename base::value_container;
 
     using value_type      = T;
     using pointer         = T*;
@@ -53,6 +62,16 @@ public:
     using iterator        = Zip_iterator<const_key_iterator, value_iterator>;
     using difference_type = std::iter_difference_t<iterator>;
     using emplace_result  = Emplace_result<key_type, value_type>;
+    using key_range       = std::ranges::subrange<const_key_iterator>;
+
+    constexpr Slot_map() = default;
+
+    // Constructs the arrays with the allocator, e.g. the RawAllocator of a salt::memory::slot_map,
+    // so the map allocates from it instead of the heap. The arrays may refer to the allocator, so
+    // it is taken by lvalue reference and must outlive the map.
+    template <typename Allocator>
+    constexpr explicit Slot_map(Allocator& allocator)
+        requires detail::constructible_with_allocator<Slot_map, Allocator>;
 
     // clang-format off
     static constexpr size_type max_size() noexcept { return free_idx_null - index_type{1}; }
@@ -77,14 +96,48 @@ public:
     [[nodiscard]] constexpr key_type insert(value_type&& value)
         requires std::move_constructible<value_type>;
 
+    // Inserts an element, it throws std::length_error if the map already has max_size() elements.
     // clang-format off
     template <typename... Args> requires std::constructible_from<value_type, Args&&...>
     [[nodiscard]] constexpr emplace_result emplace(Args&&... args);
     // clang-format on
 
+    // Inserts all elements of the range, it returns the keys of the new elements, which stay valid
+    // until the next insertion.
+    // clang-format off
+    template <std::ranges::input_range R>
+        requires std::constructible_from<value_type, std::ranges::range_reference_t<R>>
+    [[nodiscard]] constexpr key_range insert_range(R&& range);
+
+    template <typename... Args> requires std::constructible_from<value_type, Args const&...>
+    [[nodiscard]] constexpr key_range emplace_n(size_type count, Args const&... args);
+    // clang-format on
+
     constexpr iterator erase(iterator it) noexcept;
     constexpr void     erase(key_type key) noexcept;
 
+    // Erases the elements of the keys in one pass over the values, which keeps the order of the
+    // other elements. The keys must be valid and unique.
+    constexpr void erase(std::span<key_type const> erased_keys) noexcept;
+
+    // Erases the elements for which `pred` returns true in one pass over the values, like `erase`
+    // of a span. `pred` is called with the (key, value) pair an iterator refers to, if it throws
+    // the elements that were not tested yet are kept. It returns the number of erased elements.
+    template <typename Pred>
+    constexpr size_type erase_if(Pred pred)
+        requires std::predicate<Pred&, std::iter_reference_t<iterator>>;
+
+    // Sorts the elements by their values to restore the locality of a traversal after erasing
+    // scattered them. The keys are moved with their values, so they stay valid. It allocates a
+    // permutation of the positions.
+    template <typename Comp = std::ranges::less, typename Proj = std::identity>
+    constexpr void sort(Comp comp = {}, Proj proj = {})
+        requires std::sortable<value_iterator, Comp, Proj>;
+
+    // Moves the element at `permutation[i]` to the position `i`, the keys stay valid. The
+    // permutation must hold each position of the map exactly once.
+    constexpr void reorder(std::span<size_type const> permutation) noexcept;
+
     constexpr value_type pop(key_type key) noexcept;
     constexpr void       swap(Slot_map& other) noexcept;
 
@@ -110,21 +163,61 @@ public:
 
     constexpr bool contains(key_type key) const noexcept;
 
+    using base::indices;
     using base::keys;
     using base::values;
 
+    // The head of the list of free slots, with the arrays of the values, keys and indices it is the
+    // whole state of the map, e.g. for a snapshot.
+    constexpr index_type free_index() const noexcept;
+
+    // Replaces the state of the map with arrays saved from a map of the same type, the keys of that
+    // map stay valid.
+    constexpr void restore(value_container saved_values, key_container saved_keys,
+                           index_container saved_indices, index_type saved_free_index) noexcept;
+
     constexpr bool operator==(Slot_map const& other) const noexcept;
 
 private:
+    // The free slots form a list through the index array, the end of the list is the largest index.
+    static constexpr index_type free_idx_null = base::key_type::index_mask;
+    index_type                  free_idx_     = free_idx_null;
+
+    // An entry of the index array holds the generation of the slot in the same bits as a key.
+    static constexpr index_type make_entry(index_type idx, index_type generation) noexcept {
+        if constexpr (key_type::generation_bits == 0u)
+            return idx;
+        else
+            return static_cast<index_type>(idx | (generation << key_type::index_bits));
+    }
+
+    static constexpr bool same_generation(index_type entry, key_type key) noexcept {
+        return key_type{entry}.generation() == key.generation();
+    }
+
     constexpr index_type index(key_type key) const noexcept {
-        SALT_ASSERT(key.idx < indices_.size());
-        auto const idx = indices_[key.idx];
+        SALT_ASSERT(key.index() < indices_.size());
+        auto const entry = indices_[key.index()];
+        SALT_ASSERT(same_generation(entry, key));
+        auto const idx = key_type{entry}.index();
         SALT_ASSERT(idx < values_.size());
         return idx;
     }
 
+    // The keys and values with a mutable key, for algorithms that move whole elements.
+    constexpr auto element_begin() noexcept {
+        return Zip_iterator{keys_.begin(), values_.begin()};
+    }
+
     constexpr void erase_impl(index_type value_idx) noexcept;
     constexpr void erase_index_and_key(index_type value_idx) noexcept;
+
+    // Pushes the slot of the key into the free list and increments its generation.
+    constexpr void free_slot(key_type key) noexcept;
+
+    // Moves the elements that are not `erased` to the front in their order and fixes up their
+    // indices, then pops the others. It returns the number of popped elements.
+    template <typename Pred> constexpr size_type compact(Pred erased);
 };
 
 #include <salt/foundation/slot_map.inl>
@@ -6,10 +6,18 @@ SALT_DISABLE_WARNING_MICROSOFT_TEMPLATE
     template <typename T,                                                                          \
               std::unsigned_integral KeyType,                                                      \
               template <typename...> typename ValueContainer,                                      \
-              template <typename...> typename KeyContainer>                                        \
+              template <typename...> typename KeyContainer,                                        \
+              std::size_t GenerationBits>                                                          \
     requires slottable<T, KeyType, ValueContainer, KeyContainer>
 // clang-format on
-#define SLOT_MAP Slot_map<T, KeyType, ValueContainer, KeyContainer>
+#define SLOT_MAP Slot_map<T, KeyType, ValueContainer, KeyContainer, GenerationBits>
+
+SLOT_MAP_TEMPLATE
+template <typename Allocator>
+constexpr SLOT_MAP::Slot_map(Allocator& allocator)
+    requires detail::constructible_with_allocator<Slot_map, Allocator>
+        : base{allocator}
+{}
 
 SLOT_MAP_TEMPLATE
 constexpr void SLOT_MAP::reserve(size_type size)
@@ -93,7 +101,7 @@ constexpr void SLOT_MAP::clear() noexcept {
     values_.clear();
     // Push all objects into free indices list
     for (auto key : keys_) {
-        indices_[key.idx] = std::exchange(free_idx_, key.idx);
+        free_slot(key);
     }
     keys_.clear();
 }
@@ -116,6 +124,10 @@ constexpr auto SLOT_MAP::insert(value_type&& value) -> key_type
 SLOT_MAP_TEMPLATE
 template <typename... Args> requires std::constructible_from<T, Args&&...>
 constexpr auto SLOT_MAP::emplace(Args&&... args) -> emplace_result {
+    // The next index would overflow into the generation bits or be the null of the free list.
+    if (size() == max_size()) [[unlikely]] {
+        throw std::length_error("salt::Slot_map: the keys have no index left");
+    }
     index_type value_idx = static_cast<index_type>(values_.size());
 
     if (free_idx_ == free_idx_null) {
@@ -125,13 +137,13 @@ constexpr auto SLOT_MAP::emplace(Args&&... args) -> emplace_result {
 
     keys_.resize(value_idx + 1);
 
-    auto free_idx      = free_idx_;
-    auto free_idx_next = indices_[free_idx];
+    auto free_idx   = free_idx_;
+    auto free_entry = key_type{indices_[free_idx]};
 
     auto& ref = values_.emplace_back(std::forward<Args>(args)...);
-    auto  key = keys_.back() = {.idx = free_idx};
-    indices_[free_idx]       = value_idx;
-    free_idx_                = free_idx_next;
+    auto  key = keys_.back() = {.idx = make_entry(free_idx, free_entry.generation())};
+    indices_[free_idx]       = make_entry(value_idx, free_entry.generation());
+    free_idx_                = free_entry.index();
 
     return {
         .key = key,
@@ -140,6 +152,42 @@ constexpr auto SLOT_MAP::emplace(Args&&... args) -> emplace_result {
 }
 // clang-format on
 
+// clang-format off
+SLOT_MAP_TEMPLATE
+template <std::ranges::input_range R>
+    requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+constexpr auto SLOT_MAP::insert_range(R&& range) -> key_range {
+    auto const first = static_cast<difference_type>(size());
+    if constexpr (std::ranges::sized_range<R> and detail::has_reserve<Slot_map> and
+                  detail::has_capacity<Slot_map>) {
+        // Grow geometrically, so inserting many small ranges stays linear.
+        auto const required = size() + static_cast<size_type>(std::ranges::size(range));
+        if (required > capacity()) {
+            reserve(std::max(required, 2u * capacity()));
+        }
+    }
+    for (auto&& value : range) {
+        (void)emplace(std::forward<decltype(value)>(value));
+    }
+    return {keys().begin() + first, keys().end()};
+}
+
+SLOT_MAP_TEMPLATE
+template <typename... Args> requires std::constructible_from<T, Args const&...>
+constexpr auto SLOT_MAP::emplace_n(size_type count, Args const&... args) -> key_range {
+    auto const first = static_cast<difference_type>(size());
+    if constexpr (detail::has_reserve<Slot_map> and detail::has_capacity<Slot_map>) {
+        if (size() + count > capacity()) {
+            reserve(std::max(size() + count, 2u * capacity()));
+        }
+    }
+    for (size_type i = 0; i != count; ++i) {
+        (void)emplace(args...);
+    }
+    return {keys().begin() + first, keys().end()};
+}
+// clang-format on
+
 SLOT_MAP_TEMPLATE
 constexpr auto SLOT_MAP::erase(iterator it) noexcept -> iterator {
     auto value_idx = ranges::distance(begin(), it);
@@ -152,6 +200,36 @@ constexpr void SLOT_MAP::erase(key_type key) noexcept {
     erase_impl(index(key));
 }
 
+SLOT_MAP_TEMPLATE
+constexpr void SLOT_MAP::erase(std::span<key_type const> erased_keys) noexcept {
+    // The slots are freed first and the values are marked by a key with the null index, so the
+    // pass over the values doesn't have to look the keys up.
+    for (auto key : erased_keys) {
+        auto const value_idx = index(key);
+        SALT_ASSERT(keys_[value_idx] == key);
+        keys_[value_idx] = key_type{free_idx_null};
+        free_slot(key);
+    }
+    (void)compact([this](index_type value_idx) noexcept {
+        return keys_[value_idx].index() == free_idx_null;
+    });
+}
+
+SLOT_MAP_TEMPLATE
+template <typename Pred>
+constexpr auto SLOT_MAP::erase_if(Pred pred) -> size_type
+    requires std::predicate<Pred&, std::iter_reference_t<iterator>>
+{
+    auto const first = begin();
+    return compact([this, first, &pred](index_type value_idx) {
+        if (not std::invoke(pred, first[difference_type(value_idx)])) {
+            return false;
+        }
+        free_slot(keys_[value_idx]);
+        return true;
+    });
+}
+
 SLOT_MAP_TEMPLATE
 constexpr auto SLOT_MAP::access(key_type key) noexcept -> iterator {
     return std::ranges::next(begin(), index(key));
@@ -162,6 +240,42 @@ constexpr auto SLOT_MAP::access(key_type key) const noexcept -> const_iterator {
     return std::ranges::next(begin(), index(key));
 }
 
+SLOT_MAP_TEMPLATE
+template <typename Comp, typename Proj>
+constexpr void SLOT_MAP::sort(Comp comp, Proj proj)
+    requires std::sortable<value_iterator, Comp, Proj>
+{
+    // The positions are sorted instead of the elements, so each element is moved only once.
+    std::vector<size_type> permutation(values_.size());
+    std::iota(permutation.begin(), permutation.end(), size_type{0});
+    std::ranges::sort(permutation, comp, [this, &proj](size_type value_idx) -> decltype(auto) {
+        return std::invoke(proj, std::as_const(values_[value_idx]));
+    });
+    reorder(permutation);
+}
+
+SLOT_MAP_TEMPLATE
+constexpr void SLOT_MAP::reorder(std::span<size_type const> permutation) noexcept {
+    SALT_ASSERT(permutation.size() == values_.size());
+
+    // The index entries are set to the new positions first, then each element is swapped into its
+    // position, which places at least one element per swap.
+    for (index_type value_idx = 0; value_idx != permutation.size(); ++value_idx) {
+        SALT_ASSERT(permutation[value_idx] < values_.size());
+        auto const key        = keys_[permutation[value_idx]];
+        indices_[key.index()] = make_entry(value_idx, key.generation());
+    }
+
+    auto const first = element_begin();
+    for (index_type value_idx = 0; value_idx != permutation.size(); ++value_idx) {
+        for (auto target = index(keys_[value_idx]); target != value_idx;
+             target      = index(keys_[value_idx])) {
+            std::ranges::iter_swap(first + difference_type(value_idx),
+                                   first + difference_type(target));
+        }
+    }
+}
+
 SLOT_MAP_TEMPLATE
 constexpr auto SLOT_MAP::pop(key_type key) noexcept -> value_type {
     auto value_idx = index(key);
@@ -214,8 +328,70 @@ constexpr void SLOT_MAP::erase_index_and_key(index_type value_idx) noexcept {
     auto erase_key = std::exchange(keys_[value_idx], back_key);
     keys_.pop_back();
 
-    indices_[back_key.idx]  = value_idx;
-    indices_[erase_key.idx] = std::exchange(free_idx_, erase_key.idx);
+    indices_[back_key.index()] = make_entry(value_idx, back_key.generation());
+    free_slot(erase_key);
+}
+
+SLOT_MAP_TEMPLATE
+constexpr void SLOT_MAP::free_slot(key_type key) noexcept {
+    auto const generation = static_cast<index_type>(key.generation() + 1u);
+    indices_[key.index()] = make_entry(std::exchange(free_idx_, key.index()), generation);
+}
+
+SLOT_MAP_TEMPLATE
+template <typename Pred>
+constexpr auto SLOT_MAP::compact(Pred erased) -> size_type {
+    auto const size = static_cast<index_type>(values_.size());
+    auto       out  = index_type{0};
+    auto       in   = index_type{0};
+
+    auto const keep = [&]() noexcept {
+        if (out != in) {
+            values_[out] = std::move(values_[in]);
+            auto const key = keys_[out] = keys_[in];
+            indices_[key.index()]       = make_entry(out, key.generation());
+        }
+        ++out;
+    };
+    auto const pop = [&]() noexcept {
+        while (values_.size() != out) {
+            values_.pop_back();
+        }
+        keys_.resize(out);
+    };
+
+    try {
+        for (; in != size; ++in) {
+            if (not erased(in)) {
+                keep();
+            }
+        }
+    } catch (...) {
+        for (; in != size; ++in) {
+            keep();
+        }
+        pop();
+        throw;
+    }
+    pop();
+    return size - out;
+}
+
+SLOT_MAP_TEMPLATE
+constexpr auto SLOT_MAP::free_index() const noexcept -> index_type {
+    return free_idx_;
+}
+
+SLOT_MAP_TEMPLATE
+constexpr void SLOT_MAP::restore(value_container saved_values, key_container saved_keys,
+                                 index_container saved_indices,
+                                 index_type      saved_free_index) noexcept {
+    SALT_ASSERT(ranges::distance(saved_values.begin(), saved_values.end()) ==
+                ranges::distance(saved_keys.begin(), saved_keys.end()));
+    std::ranges::swap(values_, saved_values);
+    std::ranges::swap(keys_, saved_keys);
+    std::ranges::swap(indices_, saved_indices);
+    free_idx_ = saved_free_index;
 }
 
 SLOT_MAP_TEMPLATE
@@ -226,12 +402,21 @@ constexpr void SLOT_MAP::swap(SLOT_MAP& other) noexcept {
     std::ranges::swap(free_idx_, other.free_idx_);
 }
 
+// With generations the index array entry validates the key, otherwise the key array does.
 #define SALT_SLOT_MAP_FIND(key)                                                                    \
-    if (key.idx < indices_.size()) {                                                               \
-        auto value_idx = indices_[key.idx];                                                        \
-        auto it        = std::ranges::next(begin(), difference_type(value_idx), end());            \
-        if (it < end() and it->first == key) {                                                     \
-            return it;                                                                             \
+    if (key.index() < indices_.size()) {                                                           \
+        auto entry = indices_[key.index()];                                                        \
+        if constexpr (key_type::generation_bits != 0u) {                                           \
+            if (not same_generation(entry, key)) {                                                 \
+                return end();                                                                      \
+            }                                                                                      \
+        }                                                                                          \
+        auto value_idx = key_type{entry}.index();                                                  \
+        if (value_idx < values_.size()) {                                                          \
+            auto it = std::ranges::next(begin(), difference_type(value_idx));                      \
+            if (key_type::generation_bits != 0u or it->first == key) {                             \
+                return it;                                                                         \
+            }                                                                                      \
         }                                                                                          \
     }                                                                                              \
     return end();
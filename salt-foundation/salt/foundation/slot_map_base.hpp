@@ -3,6 +3,8 @@
 #include <salt/foundation/zip_iterator.hpp>
 #include <salt/meta.hpp>
 
+#include <limits>
+
 #if SALT_TARGET(APPLE)
 #    define SALT_LIBCPP_HAS_NO_RANGES (1)
 #else
@@ -36,19 +38,44 @@ struct [[nodiscard]] Container_view : private Container {
     // clang-format on
 
     constexpr decltype(auto) operator[](typename Container::size_type idx) noexcept {
-        return begin()[idx];
+        return begin()[static_cast<typename Container::difference_type>(idx)];
     }
     constexpr decltype(auto) operator[](typename Container::size_type idx) const noexcept {
-        return begin()[idx];
+        return begin()[static_cast<typename Container::difference_type>(idx)];
     }
 };
 
-template <std::unsigned_integral I>
+// The key of a Slot_map element. With GenerationBits the upper bits of `idx` hold the generation
+// of the slot, it is incremented every time the slot is erased, so a key of an erased element is
+// not found even after its slot is reused. E.g. Key<std::uint32_t, 8> is a 32-bit handle with 24
+// index bits.
+// NOTE:
+//  The generation wraps around, a key is only detected as stale until its slot is reused
+//  2^GenerationBits times.
+template <std::unsigned_integral I, std::size_t GenerationBits = 0u>
 struct Key final {
+    static_assert(GenerationBits < std::numeric_limits<I>::digits);
+
     using index_type = I;
 
+    static constexpr std::size_t generation_bits = GenerationBits;
+    static constexpr std::size_t index_bits      = std::numeric_limits<I>::digits - GenerationBits;
+    static constexpr index_type  index_mask      = std::numeric_limits<I>::max() >> GenerationBits;
+
     index_type     idx;
     constexpr auto operator<=>(Key const&) const noexcept = default;
+
+    // The slot of the key without the generation.
+    constexpr index_type index() const noexcept {
+        return idx & index_mask;
+    }
+
+    constexpr index_type generation() const noexcept {
+        if constexpr (GenerationBits == 0u)
+            return index_type{0};
+        else
+            return static_cast<index_type>(idx >> index_bits);
+    }
 };
 
 template <typename Key, typename Value>
@@ -77,6 +104,12 @@ concept has_shrink_to_fit =
 
 template <typename SlotMap>
 concept has_data = has_data<typename SlotMap::value_container>;
+
+template <typename SlotMap, typename Allocator>
+concept constructible_with_allocator =
+    std::constructible_from<typename SlotMap::value_container, Allocator&> and
+    std::constructible_from<typename SlotMap::index_container, Allocator&> and
+    std::constructible_from<typename SlotMap::key_container,   Allocator&>;
 // clang-format on
 
 } // namespace detail
@@ -102,12 +135,13 @@ template <
     typename T,
     std::unsigned_integral I,
     template <typename...> typename ValueContainer,
-    template <typename...> typename KeyContainer
+    template <typename...> typename KeyContainer,
+    std::size_t GenerationBits = 0u
 > requires slottable<T, I, ValueContainer, KeyContainer>
 // clang-format on
 struct [[nodiscard]] Slot_map_base {
 protected:
-    using key_type   = Key<I>;
+    using key_type   = Key<I, GenerationBits>;
     using index_type = typename key_type::index_type;
 
     using value_container = ValueContainer<T>;
@@ -125,11 +159,21 @@ protected:
     index_container indices_;
     key_container   keys_;
 
+    constexpr Slot_map_base() = default;
+
+    template <typename Allocator>
+    constexpr explicit Slot_map_base(Allocator& allocator)
+            : values_(allocator), indices_(allocator), keys_(allocator) {}
+
 public:
     constexpr key_view const& keys() const noexcept {
         return static_cast<key_view const&>(keys_);
     }
 
+    constexpr index_view const& indices() const noexcept {
+        return static_cast<index_view const&>(indices_);
+    }
+
     constexpr value_view& values() noexcept {
         return static_cast<value_view&>(values_);
     }
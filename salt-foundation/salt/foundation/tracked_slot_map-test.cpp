@@ -0,0 +1,126 @@
+#include <catch2/catch.hpp>
+
+#include <salt/foundation.hpp>
+
+#include <vector>
+
+using Tracked_slot_map = salt::Tracked_slot_map<int>;
+
+namespace {
+
+std::vector<int> dirty_values(Tracked_slot_map const& map) {
+    std::vector<int> values;
+    map.for_each_dirty([&](Tracked_slot_map::key_type, int const& value) {
+        values.push_back(value);
+    });
+    return values;
+}
+
+} // namespace
+
+TEST_CASE("salt::Tracked_slot_map", "[salt-foundation/tracked_slot_map.hpp]") {
+    Tracked_slot_map                        map;
+    std::vector<Tracked_slot_map::key_type> keys;
+    for (int i = 0; i < 200; i++) {
+        keys.push_back(map.insert(i));
+    }
+
+    SECTION("test insert marks") {
+        REQUIRE(map.size() == 200u);
+        REQUIRE(map.dirty_count() == 200u);
+        REQUIRE(map.dirty_words().size() == 4u);
+        REQUIRE(map.is_dirty(keys[150]));
+    }
+
+    SECTION("test mutable access marks") {
+        map.clear_dirty();
+        REQUIRE(map.dirty_count() == 0u);
+        REQUIRE(dirty_values(map).empty());
+
+        std::as_const(map)[keys[3]];
+        REQUIRE(map.dirty_count() == 0u);
+
+        map[keys[130]] += 1000;
+        map[keys[3]] += 1000;
+        map.mark(keys[64]);
+        REQUIRE(map.dirty_count() == 3u);
+        REQUIRE(dirty_values(map) == std::vector{1003, 64, 1130});
+        REQUIRE(map.dirty_words()[1] == 1u);
+    }
+
+    SECTION("test for each dirty") {
+        map.clear_dirty();
+        map.mark(keys[10]);
+        map.mark(keys[199]);
+        map.for_each_dirty([&](Tracked_slot_map::key_type key, int& value) {
+            REQUIRE(map.find(key)->second == value);
+            value = -value;
+        });
+        REQUIRE(map[keys[10]] == -10);
+        REQUIRE(map[keys[199]] == -199);
+        REQUIRE(map[keys[11]] == 11);
+    }
+
+    SECTION("test erase moves the bit of the last element") {
+        map.clear_dirty();
+        map.mark(keys[199]);
+        map.erase(keys[5]);
+        REQUIRE(map.size() == 199u);
+        REQUIRE(map.is_dirty(keys[199]));
+        REQUIRE(map.dirty_count() == 1u);
+        REQUIRE(dirty_values(map) == std::vector{199});
+
+        map.erase(keys[199]);
+        REQUIRE(map.dirty_count() == 0u);
+
+        for (int i = 0; i < 200; i++) {
+            if (i != 5 and i != 199) {
+                map.erase(keys[std::size_t(i)]);
+            }
+        }
+        REQUIRE(map.empty());
+        REQUIRE(map.dirty_words().empty());
+    }
+
+    SECTION("test the bits follow the keys") {
+        map.clear_dirty();
+        for (std::size_t i = 0; i < keys.size(); i += 3) {
+            map.mark(keys[i]);
+        }
+        for (std::size_t i = 0; i < keys.size(); i += 4) {
+            map.erase(keys[i]);
+        }
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            if (i % 4 != 0) {
+                REQUIRE(map.is_dirty(keys[i]) == (i % 3 == 0));
+            }
+        }
+        for (auto value : dirty_values(map)) {
+            REQUIRE(value % 3 == 0);
+        }
+    }
+
+    SECTION("test the bitset grows geometrically") {
+        map.clear();
+        std::size_t reallocations = 0u;
+        auto const* words         = map.dirty_words().data();
+        for (int i = 0; i < 64 * 1024; i++) {
+            (void)map.insert(i);
+            if (map.dirty_words().data() != words) {
+                words = map.dirty_words().data();
+                reallocations++;
+            }
+        }
+        REQUIRE(map.dirty_words().size() == 1024u);
+        REQUIRE(reallocations <= 11u);
+    }
+
+    SECTION("test clear") {
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(map.dirty_count() == 0u);
+        auto k = map.insert(1);
+        REQUIRE(map.is_dirty(k));
+        REQUIRE_FALSE(map.contains(keys[0]));
+    }
+}
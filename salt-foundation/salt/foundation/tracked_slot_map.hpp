@@ -0,0 +1,203 @@
+#pragma once
+#include <salt/foundation/slot_map.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace salt {
+
+// A Slot_map that remembers which elements changed, so a system that processes the elements each
+// frame can do work proportional to the changes instead of the size. A bitset parallel to the
+// values has a bit per element, which is set when the element is inserted or accessed mutably and
+// follows the swap-and-pop erase of the Slot_map, so the n-th bit belongs to the n-th key.
+// NOTE:
+//  * The changed elements are visited by scanning the bitset a word of 64 elements at a time, a
+//    word without changes is skipped by a single compare.
+//  * A change made through a reference that was obtained earlier is only seen after `mark`.
+template <typename T, std::unsigned_integral KeyType = unsigned>
+class [[nodiscard]] Tracked_slot_map {
+    using slot_map  = Slot_map<T, KeyType>;
+    using word_type = std::uint64_t;
+
+public:
+    using key_type        = typename slot_map::key_type;
+    using size_type       = typename slot_map::size_type;
+    using value_type      = T;
+    using const_iterator  = typename slot_map::const_iterator;
+    using difference_type = typename slot_map::difference_type;
+
+    static constexpr size_type word_bits = 64u;
+
+    // clang-format off
+    static constexpr size_type max_size() noexcept { return slot_map::max_size(); }
+
+    constexpr const_iterator begin() const noexcept { return slot_map_.begin(); }
+    constexpr const_iterator end()   const noexcept { return slot_map_.end();   }
+
+    constexpr size_type size()  const noexcept { return slot_map_.size();  }
+    constexpr bool      empty() const noexcept { return slot_map_.empty(); }
+    // clang-format on
+
+    constexpr void clear() noexcept {
+        slot_map_.clear();
+        dirty_.clear();
+    }
+
+    constexpr void reserve(size_type size) {
+        slot_map_.reserve(size);
+        dirty_.reserve(word_count(size));
+    }
+
+    // Inserts an element, it is marked as changed.
+    // clang-format off
+    template <typename... Args> requires std::constructible_from<T, Args&&...>
+    [[nodiscard]] constexpr key_type emplace(Args&&... args) {
+        grow_dirty(word_count(size() + 1u));
+        auto const key = slot_map_.emplace(std::forward<Args>(args)...).key;
+        dirty_.resize(word_count(size()));
+        set(size() - 1u);
+        return key;
+    }
+    // clang-format on
+
+    [[nodiscard]] constexpr key_type insert(T value) {
+        return emplace(std::move(value));
+    }
+
+    // Erases the element like the Slot_map, the bit of the last element is moved into its place.
+    constexpr void erase(key_type key) noexcept {
+        auto const idx  = index(key);
+        auto const last = size() - 1u;
+        slot_map_.erase(key);
+        if (test(last))
+            set(idx);
+        else
+            reset(idx);
+        reset(last);
+        dirty_.resize(word_count(last));
+    }
+
+    constexpr const_iterator find(key_type key) const noexcept {
+        return slot_map_.find(key);
+    }
+
+    constexpr bool contains(key_type key) const noexcept {
+        return slot_map_.contains(key);
+    }
+
+    // Returns the element of the key and marks it as changed.
+    constexpr T& operator[](key_type key) noexcept {
+        auto const idx = index(key);
+        set(idx);
+        return slot_map_.data()[idx];
+    }
+
+    constexpr T const& operator[](key_type key) const noexcept {
+        return slot_map_[key];
+    }
+
+    // Marks the element of the key as changed.
+    constexpr void mark(key_type key) noexcept {
+        set(index(key));
+    }
+
+    constexpr bool is_dirty(key_type key) const noexcept {
+        return test(index(key));
+    }
+
+    // The number of changed elements.
+    constexpr size_type dirty_count() const noexcept {
+        size_type count = 0u;
+        for (auto const word : dirty_)
+            count += static_cast<size_type>(std::popcount(word));
+        return count;
+    }
+
+    // Marks all elements as unchanged, usually after they were processed.
+    constexpr void clear_dirty() noexcept {
+        std::ranges::fill(dirty_, word_type{0});
+    }
+
+    // Calls `function(key, value)` for each changed element in the order of the values. The
+    // function must not insert or erase elements.
+    template <typename Function>
+    constexpr void for_each_dirty(Function function)
+        requires std::invocable<Function&, key_type, T&>
+    {
+        visit_dirty([&](size_type idx) {
+            std::invoke(function, slot_map_.keys()[idx], slot_map_.data()[idx]);
+        });
+    }
+
+    template <typename Function>
+    constexpr void for_each_dirty(Function function) const
+        requires std::invocable<Function&, key_type, T const&>
+    {
+        visit_dirty([&](size_type idx) {
+            std::invoke(function, slot_map_.keys()[idx], slot_map_.data()[idx]);
+        });
+    }
+
+    // The values and keys ordered like the bits.
+    constexpr std::span<T const> values() const noexcept {
+        return {slot_map_.data(), slot_map_.size()};
+    }
+
+    constexpr std::span<key_type const> keys() const noexcept {
+        return {slot_map_.keys().begin(), slot_map_.keys().end()};
+    }
+
+    // The bitset of the changed elements, the bit `i % 64` of the word `i / 64` belongs to the
+    // i-th value.
+    constexpr std::span<word_type const> dirty_words() const noexcept {
+        return dirty_;
+    }
+
+private:
+    static constexpr size_type word_count(size_type size) noexcept {
+        return (size + word_bits - 1u) / word_bits;
+    }
+
+    static constexpr word_type bit(size_type idx) noexcept {
+        return word_type{1} << (idx % word_bits);
+    }
+
+    // Makes room for the bits before the element is inserted, so the insert cannot fail after the
+    // element was added. The capacity grows geometrically like the values.
+    constexpr void grow_dirty(size_type words) {
+        if (words > dirty_.capacity())
+            dirty_.reserve(std::max<size_type>(words, 2u * dirty_.capacity()));
+    }
+
+    constexpr size_type index(key_type key) const noexcept {
+        return static_cast<size_type>(slot_map_.access(key) - slot_map_.begin());
+    }
+
+    constexpr bool test(size_type idx) const noexcept {
+        return (dirty_[idx / word_bits] & bit(idx)) != 0u;
+    }
+
+    constexpr void set(size_type idx) noexcept {
+        dirty_[idx / word_bits] |= bit(idx);
+    }
+
+    constexpr void reset(size_type idx) noexcept {
+        dirty_[idx / word_bits] &= ~bit(idx);
+    }
+
+    template <typename Visit> constexpr void visit_dirty(Visit const& visit) const {
+        for (size_type w = 0u; w != dirty_.size(); ++w)
+            for (auto word = dirty_[w]; word != 0u; word &= word - 1u)
+                visit(w * word_bits + static_cast<size_type>(std::countr_zero(word)));
+    }
+
+    slot_map               slot_map_;
+    std::vector<word_type> dirty_;
+};
+
+} // namespace salt
@@ -1,6 +1,9 @@
 #pragma once
 #include <salt/foundation/pair.hpp>
 
+#include <tuple>
+#include <utility>
+
 namespace salt {
 
 template <std::random_access_iterator Iter0, std::random_access_iterator Iter1>
@@ -163,4 +166,89 @@ operator+(typename Zip_iterator<Iter0, Iter1>::difference_type d,
     return it + d;
 }
 
+// A Zip_iterator over any number of iterators, it dereferences to a tuple of their references.
+// NOTE:
+//  std::tuple has no common reference with a tuple of values before C++23, so it doesn't model the
+//  standard iterator concepts, it is meant for range-based for loops with structured bindings.
+template <std::random_access_iterator... Iters>
+struct [[nodiscard]] Multi_zip_iterator final {
+    // clang-format off
+    using value_type      = std::tuple<std::iter_value_t<Iters>...>;
+    using reference       = std::tuple<std::iter_reference_t<Iters>...>;
+    using difference_type = std::common_type_t<std::iter_difference_t<Iters>...>;
+    // clang-format on
+
+    constexpr Multi_zip_iterator() noexcept = default;
+
+    constexpr explicit Multi_zip_iterator(Iters... iters) noexcept : iters_{iters...} {}
+
+    constexpr reference operator*() const noexcept {
+        return std::apply([](auto const&... iters) { return reference{*iters...}; }, iters_);
+    }
+
+    constexpr reference operator[](difference_type idx) const noexcept {
+        return *(*this + idx);
+    }
+
+    constexpr Multi_zip_iterator& operator++() noexcept {
+        return *this += 1;
+    }
+
+    constexpr Multi_zip_iterator operator++(int) noexcept {
+        auto const temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    constexpr Multi_zip_iterator& operator--() noexcept {
+        return *this -= 1;
+    }
+
+    constexpr Multi_zip_iterator operator--(int) noexcept {
+        auto const temp = *this;
+        --(*this);
+        return temp;
+    }
+
+    constexpr Multi_zip_iterator& operator+=(difference_type d) noexcept {
+        std::apply([d](auto&... iters) { ((iters += d), ...); }, iters_);
+        return *this;
+    }
+
+    constexpr Multi_zip_iterator& operator-=(difference_type d) noexcept {
+        return *this += -d;
+    }
+
+    constexpr Multi_zip_iterator operator+(difference_type d) const noexcept {
+        auto temp = *this;
+        return temp += d;
+    }
+
+    constexpr Multi_zip_iterator operator-(difference_type d) const noexcept {
+        auto temp = *this;
+        return temp -= d;
+    }
+
+    // The iterators move together, so comparing the first one is enough.
+    constexpr difference_type operator-(Multi_zip_iterator const& other) const noexcept {
+        return std::get<0>(iters_) - std::get<0>(other.iters_);
+    }
+
+    constexpr bool operator==(Multi_zip_iterator const& other) const noexcept {
+        return std::get<0>(iters_) == std::get<0>(other.iters_);
+    }
+
+    constexpr auto operator<=>(Multi_zip_iterator const& other) const noexcept {
+        return std::get<0>(iters_) <=> std::get<0>(other.iters_);
+    }
+
+    // Returns the I-th zipped iterator.
+    template <std::size_t I> constexpr auto get() const noexcept {
+        return std::get<I>(iters_);
+    }
+
+private:
+    std::tuple<Iters...> iters_;
+};
+
 } // namespace salt
\ No newline at end of file
@@ -72,6 +72,18 @@ public:
         return allocator_traits::allocate_array(alloc, count, size, alignment);
     }
 
+    constexpr void* allocate_zeroed_node(size_type size, size_type alignment) {
+        lock_guard<mutex_type> lock{*this};
+        auto&&                 alloc = allocator();
+        return allocator_traits::allocate_zeroed_node(alloc, size, alignment);
+    }
+
+    constexpr void* allocate_zeroed_array(size_type count, size_type size, size_type alignment) {
+        lock_guard<mutex_type> lock{*this};
+        auto&&                 alloc = allocator();
+        return allocator_traits::allocate_zeroed_array(alloc, count, size, alignment);
+    }
+
     constexpr void deallocate_node(void* ptr, size_type size, size_type alignment) noexcept {
         lock_guard<mutex_type> lock{*this};
         auto&&                 alloc = allocator();
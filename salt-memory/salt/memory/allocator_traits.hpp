@@ -4,6 +4,8 @@
 #include <salt/foundation/fast_terminate.hpp>
 #include <salt/memory/detail/align.hpp>
 
+#include <cstring>
+
 namespace salt {
 
 namespace detail {
@@ -79,6 +81,18 @@ concept has_deallocate_array =
         { allocator.deallocate_array(array, count, size, alignment) } -> std::same_as<void>;
     };
 
+template <typename Allocator>
+concept has_allocate_zeroed_node =
+    requires(Allocator&& allocator, std::size_t size, std::size_t alignment) {
+        { allocator.allocate_zeroed_node(size, alignment) } -> std::same_as<void*>;
+    };
+
+template <typename Allocator>
+concept has_allocate_zeroed_array =
+    requires(Allocator&& allocator, std::size_t count, std::size_t size, std::size_t alignment) {
+        { allocator.allocate_zeroed_array(count, size, alignment) } -> std::same_as<void*>;
+    };
+
 template <typename Allocator>
 concept has_max_node_size =
     requires(Allocator&& allocator) {
@@ -148,6 +162,35 @@ template <typename Allocator> struct [[nodiscard]] allocator_traits final {
             return allocate_node(allocator, count * size, alignment);
     }
 
+    // Allocates memory that is filled with zeros. Allocators that know their memory is already
+    // zeroed, e.g. because it comes from fresh pages, provide `allocate_zeroed_node` to skip the
+    // clearing, the memory is cleared otherwise.
+    static constexpr void*
+    allocate_zeroed_node(allocator_type& allocator,
+                         size_type       size     ,
+                         size_type       alignment)
+    {
+        if constexpr (detail::has_allocate_zeroed_node<allocator_type>)
+            return allocator.allocate_zeroed_node(size, alignment);
+        else
+            return std::memset(allocate_node(allocator, size, alignment), 0, size);
+    }
+
+    static constexpr void*
+    allocate_zeroed_array(allocator_type& allocator,
+                          size_type       count    ,
+                          size_type       size     ,
+                          size_type       alignment)
+    {
+        if constexpr (detail::has_allocate_zeroed_array<allocator_type>)
+            return allocator.allocate_zeroed_array(count, size, alignment);
+        else if constexpr (detail::has_allocate_zeroed_node<allocator_type> ||
+                           !detail::has_allocate_array<allocator_type>)
+            return allocate_zeroed_node(allocator, count * size, alignment);
+        else
+            return std::memset(allocate_array(allocator, count, size, alignment), 0, count * size);
+    }
+
     static constexpr void
     deallocate_node(allocator_type& allocator,
                     void*           node     ,
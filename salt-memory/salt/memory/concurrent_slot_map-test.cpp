@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/concurrent_slot_map.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace salt;
+
+namespace {
+
+// Checks that a reader never sees a destroyed or half constructed value.
+struct [[nodiscard]] Checked_value final {
+    explicit Checked_value(std::uint32_t v) noexcept : value{v}, check{~v} {}
+
+    ~Checked_value() {
+        check = value;
+    }
+
+    bool valid() const noexcept {
+        return check == ~value;
+    }
+
+    std::uint32_t value;
+    std::uint32_t check;
+};
+
+} // namespace
+
+TEST_CASE("salt::Concurrent_slot_map", "[salt-memory/concurrent_slot_map.hpp]") {
+    using map_type = Concurrent_slot_map<std::string>;
+    map_type map;
+    REQUIRE(map.empty());
+
+    std::vector<map_type::key_type> keys;
+    for (std::size_t i = 0u; i != 2u * map_type::page_size; ++i)
+        keys.push_back(map.emplace(std::to_string(i)));
+    REQUIRE(map.size() == 2u * map_type::page_size);
+    REQUIRE(map.capacity() == 2u * map_type::page_size);
+
+    {
+        auto const reader = map.read();
+        REQUIRE(*reader.find(keys[0u]) == "0");
+        REQUIRE(*reader.find(keys[map_type::page_size]) == std::to_string(map_type::page_size));
+    }
+
+    SECTION("erase is deferred while a reader is alive") {
+        auto const reader = map.read();
+        auto const value  = reader.find(keys[1u]);
+
+        map.erase(keys[1u]);
+        REQUIRE(map.size() == 2u * map_type::page_size - 1u);
+        REQUIRE(!reader.contains(keys[1u]));
+        REQUIRE(map.collect() == 0u);
+        REQUIRE(map.retired_size() == 1u);
+        REQUIRE(*value == "1");
+
+        // A reader that starts after the erase doesn't hold it back.
+        {
+            auto const other = map.read();
+            REQUIRE(!other.contains(keys[1u]));
+        }
+        REQUIRE(map.collect() == 0u);
+    }
+
+    SECTION("erased slots are reused with a new generation") {
+        map.erase(keys[1u]);
+        REQUIRE(map.collect() == 1u);
+        REQUIRE(map.retired_size() == 0u);
+
+        auto const key = map.emplace("new");
+        REQUIRE(key.index() == keys[1u].index());
+        REQUIRE(key.generation() == keys[1u].generation() + 1u);
+
+        auto const reader = map.read();
+        REQUIRE(!reader.contains(keys[1u]));
+        REQUIRE(*reader.find(key) == "new");
+    }
+
+    SECTION("clear") {
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(map.retired_size() == 2u * map_type::page_size);
+        REQUIRE(map.collect() == 2u * map_type::page_size);
+        REQUIRE(!map.read().contains(keys[0u]));
+    }
+}
+
+TEST_CASE("salt::Concurrent_slot_map without indices left",
+          "[salt-memory/concurrent_slot_map.hpp]") {
+    using map_type = Concurrent_slot_map<int, std::uint16_t, 8u>;
+    map_type map;
+    REQUIRE(map_type::max_size() == 255u);
+
+    std::vector<map_type::key_type> keys;
+    for (int i = 0; i != 255; ++i)
+        keys.push_back(map.emplace(i));
+    REQUIRE_THROWS_AS(map.emplace(255), std::length_error);
+    REQUIRE(map.size() == 255u);
+
+    // A collected slot can be reused.
+    map.erase(keys[7u]);
+    REQUIRE(map.collect() == 1u);
+    REQUIRE(map.emplace(255).index() == keys[7u].index());
+}
+
+TEST_CASE("salt::Concurrent_slot_map with concurrent readers",
+          "[salt-memory/concurrent_slot_map.hpp]") {
+    using map_type = Concurrent_slot_map<Checked_value>;
+    map_type map;
+
+    // The writer replaces the element of each published key, its value is the round modulo 64.
+    std::atomic<map_type::key_type> published[64];
+    for (std::uint32_t i = 0u; i != 64u; ++i)
+        published[i].store(map.emplace(i));
+
+    std::atomic<bool>        done{false};
+    std::atomic<std::size_t> invalid{0u};
+    std::atomic<std::size_t> found{0u};
+    {
+        std::vector<std::jthread> readers;
+        for (auto i = 0; i != 4; ++i)
+            readers.emplace_back([&] {
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto const reader = map.read();
+                    for (std::uint32_t j = 0u; j != 64u; ++j) {
+                        auto const key = published[j].load(std::memory_order_acquire);
+                        if (auto const value = reader.find(key)) {
+                            found.fetch_add(1u, std::memory_order_relaxed);
+                            if (!value->valid() || value->value % 64u != j)
+                                invalid.fetch_add(1u, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            });
+
+        // Every round also keeps one more element, so the map grows while it is read.
+        std::vector<map_type::key_type> kept;
+        for (std::uint32_t round = 64u; round != 4u * map_type::page_size; ++round) {
+            auto&      key     = published[round % 64u];
+            auto const old_key = key.load(std::memory_order_relaxed);
+            key.store(map.emplace(round), std::memory_order_release);
+            map.erase(old_key);
+            kept.push_back(map.emplace(round));
+            if (round % 16u == 0u)
+                (void)map.collect();
+        }
+        done = true;
+    }
+    REQUIRE(invalid.load() == 0u);
+    REQUIRE(found.load() > 0u);
+    REQUIRE(map.capacity() >= 4u * map_type::page_size);
+}
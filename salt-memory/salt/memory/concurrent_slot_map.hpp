@@ -0,0 +1,359 @@
+#pragma once
+#include <salt/memory/allocator_traits.hpp>
+#include <salt/memory/default_allocator.hpp>
+#include <salt/memory/threading.hpp>
+
+#include <salt/config.hpp>
+#include <salt/foundation/logger.hpp>
+#include <salt/foundation/slot_map_base.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace salt {
+
+// The number of Read_guards of one Concurrent_slot_map that can be alive at the same time, a
+// further reader spins until one of them is destroyed.
+static constexpr inline std::size_t concurrent_slot_map_max_readers = 64u;
+
+// A slot map that any number of threads can read while one writer thread emplaces and erases
+// elements. Readers look elements up through a Read_guard, they never take a lock and never wait
+// for the writer. The elements live in pages that never move, growing publishes a new table of the
+// pages with a single atomic store, like RCU. An erased element is only unlinked from its slot, it
+// is destroyed and the slot is reused by `collect`, once every Read_guard that could have seen it
+// is gone. The writer calls `collect` at epoch boundaries, e.g. once per frame.
+// NOTE:
+//  * Only one thread at a time may call the functions that are not const.
+//  * The values are immutable while they are shared, an element is updated by erasing it and
+//    emplacing a new one.
+//  * The keys always have a generation, so a reader never mistakes a reused slot for its old
+//    element.
+//  * A Read_guard delays the reclamation of everything erased while it is alive, it should not be
+//    kept across epoch boundaries.
+template <typename T, std::unsigned_integral I = std::uint32_t, std::size_t GenerationBits = 8u,
+          typename RawAllocator = Default_allocator>
+class [[nodiscard]] Concurrent_slot_map : allocator_traits<RawAllocator>::allocator_type {
+    static_assert(GenerationBits != 0u, "The readers validate keys by their generation");
+
+    using allocator_traits = allocator_traits<RawAllocator>;
+
+public:
+    using key_type       = Key<I, GenerationBits>;
+    using index_type     = typename key_type::index_type;
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using allocator_type = typename allocator_traits::allocator_type;
+
+    class Read_guard;
+
+    static constexpr size_type max_readers = concurrent_slot_map_max_readers;
+
+    // The largest index marks a free slot.
+    static constexpr size_type max_size() noexcept {
+        return key_type::index_mask;
+    }
+
+private:
+    struct [[nodiscard]] Slot final {
+        std::atomic<index_type> key{key_type::index_mask};
+        alignas(T) std::byte    value[sizeof(T)];
+
+        T* get() noexcept {
+            return std::launder(reinterpret_cast<T*>(value));
+        }
+
+        T const* get() const noexcept {
+            return std::launder(reinterpret_cast<T const*>(value));
+        }
+    };
+
+public:
+    // clang-format off
+    static constexpr size_type page_size  = std::bit_floor(std::max(16u * 1024u / sizeof(Slot),
+                                                                    size_type{1}));
+    static constexpr size_type page_shift = std::countr_zero(page_size);
+    static constexpr size_type page_mask  = page_size - 1u;
+    // clang-format on
+
+    explicit Concurrent_slot_map(allocator_type allocator = allocator_type{})
+            : allocator_type{std::move(allocator)} {}
+
+    // There must be no Read_guard left.
+    ~Concurrent_slot_map() {
+        for (auto [epoch, idx] : retired_slots_)
+            std::destroy_at(slot(idx).get());
+        for (index_type idx = 0u; idx != slot_count_; ++idx)
+            if (key_of(idx).index() == idx)
+                std::destroy_at(slot(idx).get());
+        for (auto page : pages_)
+            allocator_traits::deallocate_node(allocator(), page, page_bytes, alignof(Slot));
+        for (auto [epoch, table] : retired_tables_)
+            deallocate_table(table);
+        deallocate_table(table_.load(std::memory_order_relaxed));
+    }
+
+    Concurrent_slot_map(Concurrent_slot_map const&)            = delete;
+    Concurrent_slot_map& operator=(Concurrent_slot_map const&) = delete;
+
+    // Returns a guard for reading the elements, it can be called from any thread.
+    Read_guard read() const noexcept {
+        return Read_guard{*this};
+    }
+
+    // Inserts an element, it throws std::length_error if every slot up to max_size() is in use,
+    // like a Slot_map.
+    template <typename... Args> [[nodiscard]] key_type emplace(Args&&... args) {
+        auto const reuse = not free_slots_.empty();
+        if (not reuse and slot_count_ == max_size()) [[unlikely]]
+            throw std::length_error("salt::Concurrent_slot_map: the keys have no index left");
+        if (not reuse and slot_count_ == capacity())
+            add_page();
+
+        auto const idx = reuse ? free_slots_.back() : static_cast<index_type>(slot_count_);
+        auto&      s   = slot(idx);
+        std::ranges::construct_at(s.get(), std::forward<Args>(args)...);
+
+        auto const new_key = make_key(idx, key_of(idx).generation());
+        s.key.store(new_key.idx, std::memory_order_release);
+
+        if (reuse)
+            free_slots_.pop_back();
+        else
+            ++slot_count_;
+        ++size_;
+        return new_key;
+    }
+
+    // Unlinks the element, the readers don't find it anymore, but it is only destroyed by a later
+    // `collect`.
+    void erase(key_type key) noexcept {
+        auto& s = slot(key.index());
+        SALT_ASSERT(s.key.load(std::memory_order_relaxed) == key.idx);
+        auto const generation = static_cast<index_type>(key.generation() + 1u);
+        s.key.store(make_key(key_type::index_mask, generation).idx, std::memory_order_release);
+        retired_slots_.push_back({epoch_.load(std::memory_order_relaxed), key.index()});
+        --size_;
+    }
+
+    // Erases all elements, like `erase`.
+    void clear() noexcept {
+        for (index_type idx = 0u; idx != slot_count_; ++idx)
+            if (auto const slot_key = key_of(idx); slot_key.index() == idx)
+                erase(slot_key);
+    }
+
+    // Starts a new epoch and reclaims the erased elements and page tables that no Read_guard can
+    // see anymore. It returns the number of destroyed elements.
+    size_type collect() noexcept {
+        epoch_.fetch_add(1u, std::memory_order_release);
+        // Orders the unlinking before the scan of the readers, a reader that is not seen by the
+        // scan registers afterwards and can't see the unlinked elements anymore.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto min_epoch = epoch_.load(std::memory_order_relaxed);
+        for (auto& reader : readers_)
+            if (auto const epoch = reader.epoch.load(std::memory_order_acquire); epoch != 0u)
+                min_epoch = std::min(min_epoch, epoch);
+
+        auto const slots = std::ranges::find_if(retired_slots_, [min_epoch](auto const& retired) {
+            return retired.epoch >= min_epoch;
+        });
+        auto const count = static_cast<size_type>(slots - retired_slots_.begin());
+        for (auto it = retired_slots_.begin(); it != slots; ++it) {
+            std::destroy_at(slot(it->idx).get());
+            free_slots_.push_back(it->idx);
+        }
+        retired_slots_.erase(retired_slots_.begin(), slots);
+
+        auto const tables = std::ranges::find_if(retired_tables_, [min_epoch](auto const& retired) {
+            return retired.epoch >= min_epoch;
+        });
+        for (auto it = retired_tables_.begin(); it != tables; ++it)
+            deallocate_table(it->table);
+        retired_tables_.erase(retired_tables_.begin(), tables);
+        return count;
+    }
+
+    // The number of elements that are not erased.
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0u;
+    }
+
+    // The number of erased elements that wait for `collect`.
+    size_type retired_size() const noexcept {
+        return retired_slots_.size();
+    }
+
+    size_type capacity() const noexcept {
+        return pages_.size() * page_size;
+    }
+
+    constexpr allocator_type& allocator() noexcept {
+        return *this;
+    }
+
+    constexpr allocator_type const& allocator() const noexcept {
+        return *this;
+    }
+
+private:
+    static constexpr size_type page_bytes = page_size * sizeof(Slot);
+
+    struct [[nodiscard]] Table final {
+        size_type page_count;
+
+        Slot** pages() noexcept {
+            return reinterpret_cast<Slot**>(this + 1);
+        }
+
+        Slot* const* pages() const noexcept {
+            return reinterpret_cast<Slot* const*>(this + 1);
+        }
+    };
+
+    // The epoch a reader entered in, 0 if the record is not in use.
+    struct alignas(detail::cache_line_size) [[nodiscard]] Reader_record final {
+        std::atomic<std::uint64_t> epoch{0u};
+    };
+
+    struct [[nodiscard]] Retired_slot final {
+        std::uint64_t epoch;
+        index_type    idx;
+    };
+
+    struct [[nodiscard]] Retired_table final {
+        std::uint64_t epoch;
+        Table*        table;
+    };
+
+    static constexpr key_type make_key(index_type idx, index_type generation) noexcept {
+        return {static_cast<index_type>(idx | (generation << key_type::index_bits))};
+    }
+
+    static Slot const* find(Table const* table, key_type key) noexcept {
+        auto const idx = size_type(key.index());
+        if (table == nullptr or idx >= table->page_count * page_size)
+            return nullptr;
+        auto const& s = table->pages()[idx >> page_shift][idx & page_mask];
+        return s.key.load(std::memory_order_acquire) == key.idx ? &s : nullptr;
+    }
+
+    Slot& slot(index_type idx) noexcept {
+        return pages_[idx >> page_shift][idx & page_mask];
+    }
+
+    // The key of the element in the slot, or the null index with the generation of the next one.
+    key_type key_of(index_type idx) noexcept {
+        return {slot(idx).key.load(std::memory_order_relaxed)};
+    }
+
+    static constexpr size_type table_bytes(size_type page_count) noexcept {
+        return sizeof(Table) + page_count * sizeof(Slot*);
+    }
+
+    void deallocate_table(Table* table) noexcept {
+        if (table)
+            allocator_traits::deallocate_node(allocator(), table, table_bytes(table->page_count),
+                                              alignof(Table));
+    }
+
+    // Allocates a page and publishes a table with it, the old table is retired.
+    void add_page() {
+        auto const page_count = pages_.size() + 1u;
+        pages_.reserve(page_count);
+        retired_tables_.reserve(retired_tables_.size() + 1u);
+        // Every slot is either free, alive or retired, so `erase` and `collect` never allocate.
+        retired_slots_.reserve(std::bit_ceil(page_count) * page_size);
+        free_slots_.reserve(std::bit_ceil(page_count) * page_size);
+
+        auto const table = static_cast<Table*>(allocator_traits::allocate_node(
+                allocator(), table_bytes(page_count), alignof(Table)));
+        Slot*      page  = nullptr;
+        try {
+            page = static_cast<Slot*>(
+                    allocator_traits::allocate_node(allocator(), page_bytes, alignof(Slot)));
+        } catch (...) {
+            allocator_traits::deallocate_node(allocator(), table, table_bytes(page_count),
+                                              alignof(Table));
+            throw;
+        }
+        for (size_type i = 0u; i != page_size; ++i)
+            std::ranges::construct_at(page + i);
+        pages_.push_back(page);
+
+        std::ranges::construct_at(table, Table{page_count});
+        std::ranges::copy(pages_, table->pages());
+        if (auto const old = table_.exchange(table, std::memory_order_release))
+            retired_tables_.push_back({epoch_.load(std::memory_order_relaxed), old});
+    }
+
+    // Shared with the readers.
+    std::atomic<Table*>        table_{nullptr};
+    std::atomic<std::uint64_t> epoch_{1u};
+    mutable Reader_record      readers_[max_readers];
+
+    // Only used by the writer.
+    std::vector<Slot*>         pages_;
+    std::vector<index_type>    free_slots_;
+    std::vector<Retired_slot>  retired_slots_;
+    std::vector<Retired_table> retired_tables_;
+    size_type                  slot_count_ = 0u;
+    size_type                  size_       = 0u;
+};
+
+// Registers a reader of a Concurrent_slot_map, the elements it finds stay alive until it is
+// destroyed. It can be used by the thread that created it only.
+template <typename T, std::unsigned_integral I, std::size_t GenerationBits, typename RawAllocator>
+class [[nodiscard]] Concurrent_slot_map<T, I, GenerationBits, RawAllocator>::Read_guard {
+public:
+    explicit Read_guard(Concurrent_slot_map const& map) noexcept : map_{map} {
+        auto const epoch = map.epoch_.load(std::memory_order_acquire);
+        for (auto i = detail::thread_index();; ++i) {
+            auto& reader = map.readers_[i % max_readers];
+            if (std::uint64_t expected = 0u;
+                reader.epoch.load(std::memory_order_relaxed) == 0u &&
+                reader.epoch.compare_exchange_strong(expected, epoch, std::memory_order_relaxed)) {
+                record_ = &reader.epoch;
+                break;
+            }
+            if (i % max_readers == max_readers - 1u)
+                detail::cpu_relax();
+        }
+        // Pairs with the fence of `collect`, the reads can't move before the registration.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    ~Read_guard() {
+        record_->store(0u, std::memory_order_release);
+    }
+
+    Read_guard(Read_guard const&)            = delete;
+    Read_guard& operator=(Read_guard const&) = delete;
+
+    // Returns the element of the key, or nullptr if it was erased.
+    T const* find(key_type key) const noexcept {
+        auto const s = Concurrent_slot_map::find(map_.table_.load(std::memory_order_acquire), key);
+        return s ? s->get() : nullptr;
+    }
+
+    bool contains(key_type key) const noexcept {
+        return find(key) != nullptr;
+    }
+
+private:
+    Concurrent_slot_map const&  map_;
+    std::atomic<std::uint64_t>* record_ = nullptr;
+};
+
+} // namespace salt
@@ -2,6 +2,7 @@
 
 #include <salt/memory/containers.hpp>
 #include <salt/memory/memory_pool.hpp>
+#include <salt/memory/memory_stack.hpp>
 #include <salt/memory/smart_ptr.hpp>
 #include <salt/memory/static_allocator.hpp>
 #include <salt/memory/temporary_allocator.hpp>
@@ -105,4 +106,165 @@ TEST_CASE("salt::memory::vector", "[salt-memory/containers.hpp]") {
         }
     }
 #endif
-}
\ No newline at end of file
+}
+
+namespace {
+
+// Counts the allocations that don't come from the pool of the pooled containers.
+struct [[nodiscard]] Counting_allocator {
+    using allocator_type  = Counting_allocator;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static inline std::size_t allocations = 0u;
+
+    void* allocate_node(std::size_t size, std::size_t alignment) {
+        ++allocations;
+        return salt::Heap_allocator{}.allocate_node(size, alignment);
+    }
+
+    void deallocate_node(void* node, std::size_t size, std::size_t alignment) noexcept {
+        salt::Heap_allocator{}.deallocate_node(node, size, alignment);
+    }
+};
+
+// Counts its own allocations, so the test can see which allocator a container uses.
+struct [[nodiscard]] Stateful_counting_allocator {
+    using allocator_type  = Stateful_counting_allocator;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_stateful     = std::true_type;
+
+    std::size_t allocations = 0u;
+    std::size_t live        = 0u;
+
+    void* allocate_node(std::size_t size, std::size_t alignment) {
+        ++allocations;
+        ++live;
+        return salt::Heap_allocator{}.allocate_node(size, alignment);
+    }
+
+    void deallocate_node(void* node, std::size_t size, std::size_t alignment) noexcept {
+        --live;
+        salt::Heap_allocator{}.deallocate_node(node, size, alignment);
+    }
+};
+
+} // namespace
+
+TEST_CASE("salt::memory::pooled_list", "[salt-memory/containers.hpp]") {
+    using namespace salt;
+
+    Counting_allocator::allocations = 0u;
+    memory::pooled_list<int, Counting_allocator> list;
+    for (auto i = 0; i != 100; ++i)
+        list.push_back(i);
+    REQUIRE(list.size() == 100u);
+    REQUIRE(list.back() == 99);
+
+    // The nodes come from the pool, only its state and blocks from the RawAllocator.
+    auto const allocations = Counting_allocator::allocations;
+    REQUIRE(allocations < 10u);
+
+    SECTION("copies share the pool") {
+        auto copy = list;
+        REQUIRE(copy == list);
+        REQUIRE(copy.get_allocator() == list.get_allocator());
+    }
+    SECTION("move") {
+        auto moved = std::move(list);
+        REQUIRE(moved.size() == 100u);
+        moved.pop_front();
+        moved.push_back(100);
+        REQUIRE(moved.front() == 1);
+        REQUIRE(moved.back() == 100);
+    }
+    SECTION("independent containers") {
+        memory::pooled_list<int, Counting_allocator> other;
+        REQUIRE(other.get_allocator() != list.get_allocator());
+    }
+}
+
+TEST_CASE("salt::memory::pooled_map", "[salt-memory/containers.hpp]") {
+    using namespace salt;
+
+    SECTION("map") {
+        memory::pooled_map<int, double> map;
+        for (auto i = 0; i != 100; ++i)
+            map.emplace(i, i * 0.5);
+        REQUIRE(map.size() == 100u);
+        REQUIRE(map.at(10) == 5.0);
+        map.erase(10);
+        REQUIRE(!map.contains(10));
+    }
+    SECTION("set") {
+        memory::pooled_set<int> set{3, 1, 2};
+        REQUIRE(*set.begin() == 1);
+    }
+    SECTION("unordered_map") {
+        Counting_allocator::allocations = 0u;
+        memory::pooled_unordered_map<int, int, Counting_allocator> map;
+        for (auto i = 0; i != 1000; ++i)
+            map.emplace(i, i);
+        REQUIRE(map.size() == 1000u);
+        REQUIRE(map.at(500) == 500);
+
+        // The bucket arrays come from the RawAllocator.
+        REQUIRE(Counting_allocator::allocations > 1u);
+        REQUIRE(Counting_allocator::allocations < 100u);
+    }
+    SECTION("forward_list and unordered_set") {
+        memory::pooled_forward_list<int> list{1, 2, 3};
+        REQUIRE(list.front() == 1);
+
+        memory::pooled_unordered_set<int> set{1, 2, 3};
+        REQUIRE(set.contains(2));
+    }
+}
+
+TEST_CASE("salt::memory::slot_map", "[salt-memory/containers.hpp]") {
+    using namespace salt;
+    using namespace salt::literals;
+
+    SECTION("stateful") {
+        Stateful_counting_allocator allocator;
+        {
+            memory::slot_map<int, Stateful_counting_allocator, std::uint32_t, 8u> map{allocator};
+            map.reserve(16u);
+            REQUIRE(allocator.allocations == 3u);
+
+            std::vector<decltype(map)::key_type> keys;
+            for (int i = 0; i != 100; ++i)
+                keys.push_back(map.insert(i));
+            map.erase(keys[10]);
+            REQUIRE(!map.contains(keys[10]));
+            REQUIRE(map[keys[99]] == 99);
+            REQUIRE(allocator.allocations > 3u);
+            REQUIRE(allocator.live == 3u);
+
+            // A copy allocates from the same allocator.
+            auto const copy = map;
+            REQUIRE(allocator.live == 6u);
+            REQUIRE(copy == map);
+        }
+        REQUIRE(allocator.live == 0u);
+    }
+
+    SECTION("frame arena") {
+        // The map refers to the allocator, so a temporary one is rejected.
+        using stack_slot_map = memory::slot_map<double, Memory_stack<>>;
+        static_assert(std::constructible_from<stack_slot_map, Memory_stack<>&>);
+        static_assert(!std::constructible_from<stack_slot_map, Memory_stack<>>);
+
+        Memory_stack<> stack{4_KiB};
+        auto const     marker = stack.top();
+        {
+            stack_slot_map map{stack};
+            for (int i = 0; i != 10; ++i)
+                (void)map.insert(double(i));
+            REQUIRE(map.size() == 10u);
+            REQUIRE(stack.top() != marker);
+        }
+        stack.unwind(marker);
+    }
+}
@@ -16,9 +16,12 @@
 #include <unordered_set>
 #include <vector>
 
+#include <salt/memory/memory_pool.hpp>
 #include <salt/memory/std_allocator.hpp>
 #include <salt/memory/threading.hpp>
 
+#include <salt/foundation/slot_map.hpp>
+
 namespace salt::memory {
 
 // TODO:
@@ -83,6 +86,50 @@ using string = std::basic_string<char, std::char_traits<char>, Std_allocator<cha
 
 namespace detail {
 
+// Binds the RawAllocator of a vector, so it can be the container of a Slot_map.
+template <raw_allocator RawAllocator> struct [[nodiscard]] vector_of final {
+    template <typename T> using type = vector<T, RawAllocator>;
+};
+
+} // namespace detail
+
+// A Slot_map whose values, keys and indices are allocated from a RawAllocator, e.g. a
+// Memory_stack as a frame arena or a Memory_pool_list. A stateful allocator is passed to the
+// constructor, like `slot_map<T, Memory_stack<>>{stack}`.
+template <typename T, raw_allocator RawAllocator, std::unsigned_integral KeyType = unsigned,
+          std::size_t GenerationBits = 0u>
+using slot_map = Slot_map<T, KeyType, detail::vector_of<RawAllocator>::template type,
+                          detail::vector_of<RawAllocator>::template type, GenerationBits>;
+
+// Node containers with their own Node_pool_allocator, its pool is sized for the node type of the
+// container. The bucket arrays of the unordered containers come from the RawAllocator.
+template <typename T, raw_allocator RawAllocator = Default_allocator>
+using pooled_forward_list =
+        forward_list<T, Node_pool_allocator<forward_list_node_size<T>::value, RawAllocator>>;
+
+template <typename T, raw_allocator RawAllocator = Default_allocator>
+using pooled_list = list<T, Node_pool_allocator<list_node_size<T>::value, RawAllocator>>;
+
+template <typename T, raw_allocator RawAllocator = Default_allocator>
+using pooled_set = set<T, Node_pool_allocator<set_node_size<T>::value, RawAllocator>>;
+
+template <typename Key, typename Value, raw_allocator RawAllocator = Default_allocator>
+using pooled_map =
+        map<Key, Value,
+            Node_pool_allocator<map_node_size<std::pair<Key const, Value>>::value, RawAllocator>>;
+
+template <typename T, raw_allocator RawAllocator = Default_allocator>
+using pooled_unordered_set =
+        unordered_set<T, Node_pool_allocator<unordered_set_node_size<T>::value, RawAllocator>>;
+
+template <typename Key, typename Value, raw_allocator RawAllocator = Default_allocator>
+using pooled_unordered_map = unordered_map<
+        Key, Value,
+        Node_pool_allocator<unordered_map_node_size<std::pair<Key const, Value>>::value,
+                            RawAllocator>>;
+
+namespace detail {
+
 // clang-format off
 template <typename T, typename StdAllocator>
 struct [[nodiscard]] shared_ptr_node_size_impl
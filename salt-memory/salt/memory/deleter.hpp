@@ -116,4 +116,32 @@ private:
     size_type size_;
 };
 
+// Similar to Deleter but for a joint allocation, an object together with its trailing memory. It
+// stores the total size of the allocation.
+template <typename T, raw_allocator RawAllocator> requires(not std::is_abstract_v<T>)
+struct [[nodiscard]] Joint_deleter final : Allocator_reference<RawAllocator> {
+    using allocator_type  = typename Allocator_reference<RawAllocator>::allocator_type;
+    using value_type      = T;
+    using pointer_type    = T*;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr Joint_deleter() noexcept : size_{0u} {};
+
+    constexpr Joint_deleter(Allocator_reference<RawAllocator> allocator, size_type size) noexcept
+            : Allocator_reference<RawAllocator>{allocator}, size_{size} {}
+
+    constexpr void operator()(pointer_type pointer) noexcept {
+        pointer->~value_type();
+        this->deallocate_node(pointer, size_, alignof(value_type));
+    }
+
+    constexpr size_type joint_size() const noexcept {
+        return size_;
+    }
+
+private:
+    size_type size_;
+};
+
 } // namespace salt
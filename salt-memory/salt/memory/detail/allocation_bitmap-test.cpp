@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/detail/allocation_bitmap.hpp>
+#include <salt/memory/detail/memory_list.hpp>
+#include <salt/memory/static_allocator.hpp>
+
+using namespace salt;
+using namespace salt::detail;
+
+namespace {
+
+void const* invalid_pointer = nullptr;
+
+void record_invalid_pointer(Allocator_info const&, void const* ptr) {
+    invalid_pointer = ptr;
+}
+
+} // namespace
+
+TEST_CASE("salt::detail::Allocation_bitmap", "[salt-memory/allocation_bitmap.hpp]") {
+    Static_allocator_storage<1024> a;
+    Static_allocator_storage<512>  b;
+
+    auto const        info = Allocator_info{"test", nullptr};
+    Allocation_bitmap bitmap(16u);
+    bitmap.insert(&b, 512u / 16u);
+    bitmap.insert(&a, 1024u / 16u);
+
+    auto first  = reinterpret_cast<std::byte*>(&a);
+    auto second = reinterpret_cast<std::byte*>(&b);
+    REQUIRE_FALSE(bitmap.is_allocated(first));
+
+    bitmap.allocate(first + 16u, 3u);
+    REQUIRE_FALSE(bitmap.is_allocated(first));
+    REQUIRE(bitmap.is_allocated(first + 16u));
+    REQUIRE(bitmap.is_allocated(first + 48u));
+    REQUIRE_FALSE(bitmap.is_allocated(first + 64u));
+
+    bitmap.allocate(second + 496u, 1u);
+    REQUIRE(bitmap.is_allocated(second + 496u));
+
+#if SALT_MEMORY_DEBUG_POINTER && SALT_MEMORY_DEBUG_DOUBLE_FREE
+    auto const old_handler = set_invalid_pointer_handler(record_invalid_pointer);
+
+    // A pointer into the middle of a node.
+    REQUIRE_FALSE(bitmap.deallocate(info, first + 17u, 1u));
+    REQUIRE(invalid_pointer == first + 17u);
+
+    // A pointer that does not belong to any region.
+    int value = 0;
+    REQUIRE_FALSE(bitmap.deallocate(info, &value, 1u));
+    REQUIRE(invalid_pointer == &value);
+
+    REQUIRE(bitmap.deallocate(info, first + 16u, 3u));
+    REQUIRE_FALSE(bitmap.is_allocated(first + 32u));
+
+    // A double free.
+    invalid_pointer = nullptr;
+    REQUIRE_FALSE(bitmap.deallocate(info, first + 16u, 3u));
+    REQUIRE(invalid_pointer == first + 16u);
+
+    set_invalid_pointer_handler(old_handler);
+#endif
+    REQUIRE(bitmap.deallocate(info, second + 496u, 1u));
+}
+
+TEST_CASE("salt::detail::Unordered_memory_list double free", "[salt-memory/allocation_bitmap.hpp]") {
+#if SALT_MEMORY_DEBUG_DOUBLE_FREE
+    auto const old_handler = set_invalid_pointer_handler(record_invalid_pointer);
+
+    Static_allocator_storage<1024> memory;
+    Unordered_memory_list          list(16u, &memory, 1024u);
+    auto const                     capacity = list.capacity();
+
+    auto node = list.allocate();
+    list.deallocate(node);
+    REQUIRE(list.capacity() == capacity);
+
+    invalid_pointer = nullptr;
+    list.deallocate(node);
+    REQUIRE(invalid_pointer == node);
+    REQUIRE(list.capacity() == capacity);
+
+    set_invalid_pointer_handler(old_handler);
+#endif
+}
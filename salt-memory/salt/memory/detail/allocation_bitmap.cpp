@@ -0,0 +1,84 @@
+#include <salt/memory/detail/allocation_bitmap.hpp>
+
+#include <salt/config.hpp>
+#include <salt/foundation/logger.hpp>
+#include <salt/memory/detail/debug_helpers.hpp>
+
+#include <algorithm>
+
+namespace salt::detail {
+
+void Allocation_bitmap::insert(void* memory, size_type node_count) {
+    if (node_count == 0u)
+        return;
+
+    auto const begin = reinterpret_cast<std::uintptr_t>(memory);
+    auto const end   = begin + node_count * node_size_;
+    SALT_ASSERT(!find(begin) && !find(end - 1u));
+
+    // Keep the regions sorted, so the lookup is a binary search.
+    auto const position = std::ranges::upper_bound(regions_, begin, {}, &Region::begin);
+    regions_.insert(position,
+                    Region{begin, end, std::vector<std::uint64_t>((node_count + word_bits - 1u) /
+                                                                  word_bits)});
+}
+
+void Allocation_bitmap::allocate(void* memory, size_type node_count) noexcept {
+    assign(reinterpret_cast<std::uintptr_t>(memory), node_count, true);
+}
+
+bool Allocation_bitmap::deallocate(Allocator_info const& info, void* memory,
+                                   size_type node_count) noexcept {
+    auto const address = reinterpret_cast<std::uintptr_t>(memory);
+    auto const region  = find(address);
+
+    auto const valid = region && (address - region->begin) % node_size_ == 0u;
+    debug_check_pointer([&] { return valid; }, info, memory);
+    if (!valid)
+        return false;
+
+    auto const allocated = is_allocated(memory);
+    debug_check_double_free([&] { return allocated; }, info, memory);
+    if (!allocated)
+        return false;
+
+    assign(address, node_count, false);
+    return true;
+}
+
+bool Allocation_bitmap::is_allocated(void const* memory) const noexcept {
+    auto const address = reinterpret_cast<std::uintptr_t>(memory);
+    auto const region  = find(address);
+    if (!region)
+        return false;
+
+    auto const index = (address - region->begin) / node_size_;
+    return (region->bits[index / word_bits] >> (index % word_bits)) & 1u;
+}
+
+auto Allocation_bitmap::find(std::uintptr_t address) const noexcept -> Region const* {
+    auto const position = std::ranges::upper_bound(regions_, address, {}, &Region::begin);
+    if (position == regions_.begin())
+        return nullptr;
+
+    auto const& region = *std::prev(position);
+    return address < region.end ? &region : nullptr;
+}
+
+void Allocation_bitmap::assign(std::uintptr_t address, size_type node_count, bool value) noexcept {
+    auto const region = const_cast<Region*>(find(address));
+    if (!region)
+        return;
+
+    auto const first = (address - region->begin) / node_size_;
+    SALT_ASSERT(region->begin + (first + node_count) * node_size_ <= region->end);
+    for (auto index = first; index != first + node_count; ++index) {
+        auto const mask = std::uint64_t(1u) << (index % word_bits);
+        if (value)
+            region->bits[index / word_bits] |= mask;
+        else
+            region->bits[index / word_bits] &= ~mask;
+    }
+}
+
+} // namespace salt::detail
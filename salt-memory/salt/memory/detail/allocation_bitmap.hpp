@@ -0,0 +1,75 @@
+#pragma once
+#include <salt/config/memory_support.hpp>
+#include <salt/memory/debugging.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace salt::detail {
+
+// Keeps one bit per node for every memory region inserted into a free list, the bit is set while
+// the node is allocated. It turns the pointer and double free checks of a deallocation into a bit
+// test, instead of a walk over the free list. The bits are stored outside of the regions, so the
+// usable memory is the same as without the checks.
+struct [[nodiscard]] Allocation_bitmap final {
+    using size_type = std::size_t;
+
+    explicit Allocation_bitmap(size_type node_size) noexcept : node_size_{node_size} {}
+
+    ~Allocation_bitmap() = default;
+
+    Allocation_bitmap(Allocation_bitmap&& other) noexcept            = default;
+    Allocation_bitmap& operator=(Allocation_bitmap&& other) noexcept = default;
+
+    // Registers a new region of free nodes, it throws std::bad_alloc if the bits can't be
+    // allocated and leaves the bitmap unchanged then.
+    void insert(void* memory, size_type node_count);
+
+    // Marks `node_count` consecutive nodes starting at `memory` as allocated.
+    void allocate(void* memory, size_type node_count) noexcept;
+
+    // Marks `node_count` consecutive nodes starting at `memory` as free. The pointer and double free
+    // checks are performed here, it returns false if they have failed.
+    bool deallocate(Allocator_info const& info, void* memory, size_type node_count) noexcept;
+
+    bool is_allocated(void const* memory) const noexcept;
+
+private:
+    struct [[nodiscard]] Region final {
+        std::uintptr_t             begin;
+        std::uintptr_t             end;
+        std::vector<std::uint64_t> bits;
+    };
+
+    static constexpr size_type word_bits = 64u;
+
+    // Returns the region containing the address, or nullptr.
+    Region const* find(std::uintptr_t address) const noexcept;
+
+    void assign(std::uintptr_t address, size_type node_count, bool value) noexcept;
+
+    std::vector<Region> regions_;
+    size_type           node_size_;
+};
+
+// An Allocation_bitmap that does not track anything, it is used if the debug checks are disabled.
+struct [[nodiscard]] No_allocation_bitmap final {
+    using size_type = std::size_t;
+
+    explicit constexpr No_allocation_bitmap(size_type) noexcept {}
+
+    constexpr void insert(void*, size_type) noexcept {}
+    constexpr void allocate(void*, size_type) noexcept {}
+
+    constexpr bool deallocate(Allocator_info const&, void*, size_type) noexcept {
+        return true;
+    }
+};
+
+#if SALT_MEMORY_DEBUG_POINTER || SALT_MEMORY_DEBUG_DOUBLE_FREE
+using Debug_allocation_bitmap = Allocation_bitmap;
+#else
+using Debug_allocation_bitmap = No_allocation_bitmap;
+#endif
+
+} // namespace salt::detail
@@ -2,6 +2,8 @@
 #include <salt/memory/detail/align.hpp>
 #include <salt/memory/detail/debug_helpers.hpp>
 
+#include <cstring>
+
 namespace salt::detail {
 
 template <typename Allocator> struct Low_level_allocator_leak_handler {
@@ -19,6 +21,14 @@ concept allocator_like =
         { Allocator::max_size()                           } -> std::same_as<std::size_t>;
         { Allocator::info()                               } -> std::same_as<Allocator_info>;
     };
+
+// An allocator_like that can allocate zeroed memory faster than clearing it, e.g. with calloc.
+template <typename Allocator, std::size_t Size = 1, std::size_t Alignment = 1>
+concept zeroing_allocator_like =
+    allocator_like<Allocator, Size, Alignment> and
+    requires {
+        { Allocator::allocate_zeroed(Size, Alignment) } -> std::same_as<void*>;
+    };
 // clang-format on
 
 template <allocator_like Allocator>
@@ -45,6 +55,23 @@ struct [[nodiscard]] Low_level_allocator
         return debug_fill_new(memory, size, max_alignment);
     }
 
+    constexpr void* allocate_zeroed_node(size_type size, size_type alignment) noexcept {
+        if constexpr (!zeroing_allocator_like<allocator_type>) {
+            return std::memset(allocate_node(size, alignment), 0, size);
+        } else {
+            auto actual_size = size + (debug_fence_size ? 2u * max_alignment : 0u);
+            auto memory      = allocator_type::allocate_zeroed(actual_size, alignment);
+
+            leak_detector::on_allocate(actual_size);
+
+            // The debug fill overwrites the zeros.
+            if constexpr (debug_fill_enabled::value)
+                return std::memset(debug_fill_new(memory, size, max_alignment), 0, size);
+            else
+                return memory;
+        }
+    }
+
     constexpr void deallocate_node(void* node, size_type size, size_type alignment) noexcept {
         auto actual_size = size + (debug_fence_size ? 2u * max_alignment : 0u);
         auto memory      = debug_fill_free(node, size, max_alignment);
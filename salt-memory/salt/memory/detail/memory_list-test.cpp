@@ -4,6 +4,7 @@
 #include <salt/memory/static_allocator.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <random>
 #include <vector>
 
@@ -251,3 +252,107 @@ TEST_CASE("salt::detail::Memory_list", "[salt-memory/memory_list.hpp]") {
         check_move(list);
     }
 }
+
+TEST_CASE("salt::detail::Memory_list extents", "[salt-memory/memory_list.hpp]") {
+    Static_allocator_storage<4096> memory;
+    Memory_list                    list(32, &memory, 4096);
+    auto const                     node_count = list.capacity();
+    REQUIRE(list.extent_count() == 1u);
+    REQUIRE(list.max_extent() == node_count);
+
+    SECTION("merge on deallocate") {
+        std::vector<void*> ptrs;
+        for (std::size_t i = 0u; i != node_count; ++i)
+            ptrs.push_back(list.allocate());
+        REQUIRE(list.empty());
+        REQUIRE(list.extent_count() == 0u);
+
+        for (std::size_t i = 0u; i < node_count; i += 2u)
+            list.deallocate(ptrs[i]);
+        REQUIRE(list.extent_count() == node_count / 2u);
+        REQUIRE(list.max_extent() == 1u);
+        REQUIRE(!list.allocate(2u * list.node_size()));
+
+        std::vector<void*> rest;
+        for (std::size_t i = 1u; i < node_count; i += 2u)
+            rest.push_back(ptrs[i]);
+        std::shuffle(rest.begin(), rest.end(), std::mt19937{});
+        for (auto p : rest)
+            list.deallocate(p);
+        REQUIRE(list.extent_count() == 1u);
+        REQUIRE(list.max_extent() == node_count);
+    }
+    SECTION("arrays of different sizes") {
+        std::mt19937                               generator;
+        std::uniform_int_distribution<std::size_t> counts(1u, 8u);
+        std::vector<std::pair<void*, std::size_t>> arrays;
+        for (auto count = counts(generator); list.max_extent() >= count;) {
+            auto ptr = list.allocate(count * list.node_size());
+            REQUIRE(ptr);
+            REQUIRE(is_aligned(ptr, list.alignment()));
+            arrays.emplace_back(ptr, count);
+            count = counts(generator);
+        }
+
+        std::shuffle(arrays.begin(), arrays.end(), generator);
+        for (auto [ptr, count] : arrays) {
+            list.deallocate(ptr, count * list.node_size());
+            REQUIRE(list.max_extent() <= list.capacity());
+        }
+        REQUIRE(list.capacity() == node_count);
+        REQUIRE(list.extent_count() == 1u);
+    }
+    SECTION("lowest address first") {
+        auto a = list.allocate(4u * list.node_size());
+        auto b = list.allocate(4u * list.node_size());
+        auto c = list.allocate(4u * list.node_size());
+        list.deallocate(a, 4u * list.node_size());
+        list.deallocate(c, 4u * list.node_size());
+
+        // c is merged with the memory below it, the array is taken from there and not from a.
+        REQUIRE(list.extent_count() == 2u);
+        auto d = list.allocate(3u * list.node_size());
+        REQUIRE(std::less<void*>()(d, b));
+        REQUIRE(list.max_extent() == node_count - 11u);
+
+        list.deallocate(d, 3u * list.node_size());
+        list.deallocate(b, 4u * list.node_size());
+        REQUIRE(list.extent_count() == 1u);
+    }
+}
+
+TEST_CASE("salt::detail::Memory_list single nodes", "[salt-memory/memory_list.hpp]") {
+    Static_allocator_storage<4096> memory;
+    Memory_list                    list(8, &memory, 4096);
+    auto const                     node_count = list.capacity();
+    REQUIRE(list.node_size() == 8u);
+    REQUIRE(node_count == 4096u / 8u);
+
+    std::vector<void*> ptrs;
+    for (std::size_t i = 0u; i != node_count; ++i)
+        ptrs.push_back(list.allocate());
+    REQUIRE(list.empty());
+
+    // The freed nodes are too small for an extent, they are kept as single nodes.
+    for (std::size_t i = 0u; i < node_count; i += 2u)
+        list.deallocate(ptrs[i]);
+    REQUIRE(list.extent_count() == 0u);
+    REQUIRE(list.capacity() == node_count / 2u);
+    REQUIRE(!list.allocate(2u * list.node_size()));
+
+    std::vector<void*> rest;
+    for (std::size_t i = 1u; i < node_count; i += 2u)
+        rest.push_back(ptrs[i]);
+    std::shuffle(rest.begin(), rest.end(), std::mt19937{});
+    for (auto p : rest)
+        list.deallocate(p);
+    REQUIRE(list.capacity() == node_count);
+
+    // An array that does not fit merges the single nodes into extents.
+    auto array = list.allocate(node_count * list.node_size());
+    REQUIRE(array == static_cast<void*>(&memory));
+    REQUIRE(list.empty());
+    list.deallocate(array, node_count * list.node_size());
+    REQUIRE(list.extent_count() == 1u);
+    REQUIRE(list.max_extent() == node_count);
+}
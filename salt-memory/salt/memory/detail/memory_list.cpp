@@ -5,13 +5,17 @@
 #include <salt/memory/detail/debug_helpers.hpp>
 #include <salt/memory/detail/memory_list_utils.hpp>
 
+#include <algorithm>
+#include <utility>
+
 namespace salt::detail {
 
 Unordered_memory_list::Unordered_memory_list(size_type node_size) noexcept
-        : first_{nullptr}, node_size_{node_size > min_size ? node_size : min_size}, capacity_{0u} {}
+        : first_{nullptr}, node_size_{node_size > min_size ? node_size : min_size}, capacity_{0u},
+          bitmap_{node_size_} {}
 
 Unordered_memory_list::Unordered_memory_list(size_type node_size, void* memory,
-                                             size_type size) noexcept
+                                             size_type size)
         : Unordered_memory_list{node_size} {
     insert(memory, size);
 }
@@ -20,7 +24,8 @@ Unordered_memory_list::Unordered_memory_list(size_type node_size, void* memory,
 Unordered_memory_list::Unordered_memory_list(Unordered_memory_list&& other) noexcept
         : first_    {std::exchange(other.first_, nullptr)},
           node_size_{other.node_size_},
-          capacity_ {std::exchange(other.capacity_, 0)} {}
+          capacity_ {std::exchange(other.capacity_, 0)},
+          bitmap_   {std::move(other.bitmap_)} {}
 // clang-format on
 
 Unordered_memory_list& Unordered_memory_list::operator=(Unordered_memory_list&& other) noexcept {
@@ -28,14 +33,16 @@ Unordered_memory_list& Unordered_memory_list::operator=(Unordered_memory_list&&
     first_     = tmp.first_;
     node_size_ = tmp.node_size_;
     capacity_  = tmp.capacity_;
+    bitmap_    = std::move(tmp.bitmap_);
     return *this;
 }
 
-void Unordered_memory_list::insert(void* memory, size_type size) noexcept {
+void Unordered_memory_list::insert(void* memory, size_type size) {
     SALT_ASSERT(memory);
     SALT_ASSERT(is_aligned(memory, alignment()));
     debug_fill_internal(memory, size, false);
 
+    bitmap_.insert(memory, size / node_size_);
     insert_impl(memory, size);
 }
 
@@ -45,6 +52,7 @@ void* Unordered_memory_list::allocate() noexcept {
 
     auto memory = first_;
     first_      = list::get_next(first_);
+    bitmap_.allocate(memory, 1u);
     return debug_fill_new(memory, node_size_, 0);
 }
 
@@ -61,12 +69,16 @@ void* Unordered_memory_list::allocate(size_type n) noexcept {
         list::set_next(node.prev, node.next);
     else
         first_ = node.next;
-    capacity_ -= list::node_count(range, node_size_);
+    auto const node_count = list::node_count(range, node_size_);
+    capacity_ -= node_count;
+    bitmap_.allocate(range.first, node_count);
 
     return debug_fill_new(range.first, n, 0);
 }
 
 void Unordered_memory_list::deallocate(void* ptr) noexcept {
+    if (!bitmap_.deallocate(Allocator_info{"salt::detail::Unordered_memory_list", this}, ptr, 1u))
+        return;
     ++capacity_;
 
     auto node = static_cast<iterator>(debug_fill_free(ptr, node_size_, 0));
@@ -77,7 +89,8 @@ void Unordered_memory_list::deallocate(void* ptr) noexcept {
 void Unordered_memory_list::deallocate(void* ptr, size_type n) noexcept {
     if (n <= node_size_)
         deallocate(ptr);
-    else
+    else if (bitmap_.deallocate(Allocator_info{"salt::detail::Unordered_memory_list", this}, ptr,
+                                (n + node_size_ - 1u) / node_size_))
         insert_impl(debug_fill_free(ptr, n, 0), n);
 }
 
@@ -97,105 +110,158 @@ void Unordered_memory_list::insert_impl(void* memory, size_type size) noexcept {
 
 namespace {
 
-// clang-format off
-template <typename Iterator>
-auto find_position(Allocator_info const&         info,
-                   Iterator                      begin,
-                   Contiguous_range<Iterator>    range,
-                   Random_access_range<Iterator> node) noexcept {
-    SALT_ASSERT(less(range.first, begin) && less(begin, range.last));
-    using node_type = Random_access_range<Iterator>;
-
-    auto curr_forward = range.first;
-    auto prev_forward = node.prev;
-
-    auto curr_backward = range.last;
-    auto prev_backward = node.next;
-    do {
-        if (greater(curr_forward, begin))
-            return node_type{prev_forward, curr_forward};
-        else if (less(curr_backward, begin))
-            return node_type{curr_backward, prev_backward};
-
-        debug_check_double_free(
-                [&] { return curr_forward != begin && curr_backward != begin; }, info, begin);
-        list::xor_advance(curr_forward, prev_forward);
-        list::xor_advance(curr_backward, prev_backward);
-    } while (less(prev_forward, prev_backward));
-
-    debug_check_double_free([] { return false; }, info, begin);
-    return node_type{nullptr, nullptr};
+using extent_pair = salt::cxx23::pair<Free_extent*, Free_extent*>;
+
+std::byte* begin_of(Free_extent* extent) noexcept {
+    return static_cast<std::byte*>(static_cast<void*>(extent));
 }
 
-template <typename Iterator>
-auto find_insert_position(Allocator_info const&         info,
-                          Iterator                      begin,
-                          Contiguous_range<Iterator>    range,
-                          Random_access_range<Iterator> node) noexcept {
-    using node_type  = Random_access_range<Iterator>;
-    using range_type = Contiguous_range<Iterator>;
-
-    auto new_range = range_type{.first = list::xor_get_next(range.first, nullptr),
-                                .last  = list::xor_get_next(range.last, nullptr)};
-    if (greater(new_range.first, begin))
-        return node_type{range.first, new_range.first};
-    else if (less(new_range.last, begin))
-        return node_type{new_range.last, range.last};
-    else if (less(node.prev, begin) && less(begin, node.next))
-        return node_type{node.prev, node.next};
-    else if (less(begin, node.next))
-        return find_position(info, begin, range_type{new_range.first, node.prev}, node_type{range.first, node.next});
-    else if (greater(begin, node.next))
-        return find_position(info, begin, range_type{node.next, new_range.last}, node_type{node.prev, range.last});
-
-    fast_terminate();
-    return node_type{nullptr, nullptr};
+// The treap priority of an extent, a multiplicative hash of its address.
+std::size_t priority(Free_extent const* extent) noexcept {
+    auto const hash = std::uint64_t(reinterpret_cast<std::uintptr_t>(extent)) * 0x9e3779b97f4a7c15u;
+    return std::size_t(hash ^ (hash >> 32u));
+}
+
+std::size_t max_count(Free_extent const* extent) noexcept {
+    return extent ? extent->max_count : 0u;
+}
+
+Free_extent* update(Free_extent* extent) noexcept {
+    extent->max_count =
+            std::max({extent->count, max_count(extent->left), max_count(extent->right)});
+    return extent;
+}
+
+// Splits the treap into the extents before `memory` and the extents starting at or after it.
+extent_pair split(Free_extent* extent, std::byte* memory) noexcept {
+    if (!extent)
+        return extent_pair{nullptr, nullptr};
+
+    if (less(extent, memory)) {
+        auto [left, right] = split(extent->right, memory);
+        extent->right      = left;
+        return extent_pair{update(extent), right};
+    }
+    auto [left, right] = split(extent->left, memory);
+    extent->left       = right;
+    return extent_pair{left, update(extent)};
+}
+
+// Joins two treaps, all the extents of `left` are before the extents of `right`.
+Free_extent* merge(Free_extent* left, Free_extent* right) noexcept {
+    if (!left || !right)
+        return left ? left : right;
+
+    if (priority(left) > priority(right)) {
+        left->right = merge(left->right, right);
+        return update(left);
+    }
+    right->left = merge(left, right->left);
+    return update(right);
+}
+
+// Removes the first extent of the treap and returns the rest.
+Free_extent* remove_first(Free_extent* extent, Free_extent*& first) noexcept {
+    if (extent->left) {
+        extent->left = remove_first(extent->left, first);
+        return update(extent);
+    }
+    first     = extent;
+    auto rest = std::exchange(extent->right, nullptr);
+    update(extent);
+    return rest;
+}
+
+// Removes the last extent of the treap and returns the rest.
+Free_extent* remove_last(Free_extent* extent, Free_extent*& last) noexcept {
+    if (extent->right) {
+        extent->right = remove_last(extent->right, last);
+        return update(extent);
+    }
+    last      = extent;
+    auto rest = std::exchange(extent->left, nullptr);
+    update(extent);
+    return rest;
+}
+
+// Takes `count` nodes from the end of the lowest addressed extent that has enough of them. An
+// extent left with less than `min_count` nodes is removed, `rest` is set to its remaining nodes,
+// which are right before `memory`. It returns the new root of the subtree.
+Free_extent* take(Free_extent* extent, std::size_t count, std::size_t node_size,
+                  std::size_t min_count, std::byte*& memory, std::size_t& rest) noexcept {
+    SALT_ASSERT(max_count(extent) >= count);
+    if (max_count(extent->left) >= count) {
+        extent->left = take(extent->left, count, node_size, min_count, memory, rest);
+    } else if (extent->count >= count) {
+        extent->count -= count;
+        memory = begin_of(extent) + extent->count * node_size;
+        if (extent->count < min_count) {
+            rest = extent->count;
+            return merge(extent->left, extent->right);
+        }
+    } else {
+        extent->right = take(extent->right, count, node_size, min_count, memory, rest);
+    }
+    return update(extent);
+}
+
+// Sorts the first `count` nodes of a list by address, `list` is advanced past them.
+std::byte* sort_nodes(std::byte*& list, std::size_t count) noexcept {
+    if (count == 1u) {
+        auto const node = std::exchange(list, list::get_next(list));
+        list::set_next(node, nullptr);
+        return node;
+    }
+
+    auto left  = sort_nodes(list, count / 2u);
+    auto right = sort_nodes(list, count - count / 2u);
+
+    std::byte* first  = nullptr;
+    std::byte* last   = nullptr;
+    auto const append = [&](std::byte* node) {
+        if (last)
+            list::set_next(last, node);
+        else
+            first = node;
+        last = node;
+    };
+    while (left && right) {
+        auto& smaller = less(left, right) ? left : right;
+        append(std::exchange(smaller, list::get_next(smaller)));
+    }
+    append(left ? left : right);
+    return first;
+}
+
+std::size_t count_extents(Free_extent const* extent) noexcept {
+    return extent ? 1u + count_extents(extent->left) + count_extents(extent->right) : 0u;
 }
-// clang-format on
 
 } // namespace
 
 Memory_list::Memory_list(size_type node_size) noexcept
-        : node_size_{node_size > min_size ? node_size : min_size}, capacity_{0u},
-          node_{begin_node(), end_node()} {
-    list::xor_set_next(begin_node(), nullptr, end_node());
-    list::xor_set_next(end_node(), begin_node(), nullptr);
-}
+        : root_{nullptr}, nodes_{nullptr}, node_size_{node_size > min_size ? node_size : min_size},
+          capacity_{0u} {}
 
 Memory_list::Memory_list(size_type node_size, void* memory, size_type size) noexcept
         : Memory_list{node_size} {
     insert(memory, size);
 }
 
+// clang-format off
 Memory_list::Memory_list(Memory_list&& other) noexcept
-        : node_size_{other.node_size_}, capacity_{std::exchange(other.capacity_, 0)} {
-    if (!other.empty()) {
-        auto* begin = list::xor_get_next(other.begin_node(), nullptr);
-        auto* end   = list::xor_get_next(other.end_node(), nullptr);
-
-        list::xor_set_next(begin_node(), nullptr, begin);
-        list::xor_exchange(begin, other.begin_node(), begin_node());
-        list::xor_exchange(end, other.end_node(), end_node());
-        list::xor_set_next(end_node(), end, nullptr);
-
-        list::xor_set_next(other.begin_node(), nullptr, other.end_node());
-        list::xor_set_next(other.end_node(), other.begin_node(), nullptr);
-    } else {
-        list::xor_set_next(begin_node(), nullptr, end_node());
-        list::xor_set_next(end_node(), begin_node(), nullptr);
-    }
-
-    node_.prev = begin_node();
-    node_.next = list::xor_get_next(node_.prev, nullptr);
-}
+        : root_     {std::exchange(other.root_, nullptr)},
+          nodes_    {std::exchange(other.nodes_, nullptr)},
+          node_size_{other.node_size_},
+          capacity_ {std::exchange(other.capacity_, 0)} {}
+// clang-format on
 
 Memory_list& Memory_list::operator=(Memory_list&& other) noexcept {
     Memory_list tmp{std::move(other)};
-
+    root_      = tmp.root_;
+    nodes_     = tmp.nodes_;
     node_size_ = tmp.node_size_;
     capacity_  = tmp.capacity_;
-    node_.prev = tmp.node_.prev;
-    node_.next = tmp.node_.next;
     return *this;
 }
 
@@ -204,107 +270,156 @@ void Memory_list::insert(void* memory, size_type size) noexcept {
     SALT_ASSERT(is_aligned(memory, alignment()));
     debug_fill_internal(memory, size, false);
 
-    insert_impl(memory, size);
+    insert_impl(static_cast<iterator>(memory), size / node_size_);
 }
 
 void* Memory_list::allocate() noexcept {
     SALT_ASSERT(!empty());
-
-    auto prev = begin_node();
-    auto node = list::xor_get_next(prev, nullptr);
-    auto next = list::xor_get_next(node, prev);
-
-    list::xor_set_next(prev, nullptr, next);
-    list::xor_exchange(next, node, prev);
     --capacity_;
 
-    if (node == node_.next) {
-        node_.next = next;
-        SALT_ASSERT(node_.prev == prev);
-    } else if (node == node_.prev) {
-        node_.prev = prev;
-        SALT_ASSERT(node_.next == next);
+    if (nodes_) {
+        auto const memory = std::exchange(nodes_, list::get_next(nodes_));
+        return debug_fill_new(memory, node_size_, 0);
     }
 
-    return detail::debug_fill_new(node, node_size_, 0);
+    // The root is taken from its end, which keeps it in place unless it becomes too small.
+    auto const count  = --root_->count;
+    auto const memory = begin_of(root_) + count * node_size_;
+    if (count < extent_nodes()) {
+        root_ = merge(root_->left, root_->right);
+        push_nodes(memory - count * node_size_, count);
+    } else {
+        update(root_);
+    }
+    return debug_fill_new(memory, node_size_, 0);
 }
 
 void* Memory_list::allocate(size_type n) noexcept {
     SALT_ASSERT(!empty());
-
     if (n <= node_size_)
         return allocate();
 
-    auto [node, range] = list::xor_find(memory_range{begin_node(), end_node()}, n, node_size_);
-    if (!range.first) [[unlikely]]
-        return nullptr;
-
-    list::xor_exchange(node.prev, range.first, node.next);
-    list::xor_exchange(node.next, range.last, node.prev);
-    capacity_ -= list::node_count(range, node_size_);
-
-    if ((less_equal(range.first, node_.next) && less_equal(node_.next, range.last))) {
-        node_.next = node.next;
-        node_.prev = node.prev;
-    } else if (node_.prev == range.last) {
-        SALT_ASSERT(node_.next == node.next);
-        node_.prev = node.prev;
+    auto const node_count = (n + node_size_ - 1u) / node_size_;
+    if (max_extent() < node_count) [[unlikely]] {
+        merge_nodes();
+        if (max_extent() < node_count)
+            return nullptr;
     }
 
-    return detail::debug_fill_new(range.first, n, 0);
+    iterator  memory = nullptr;
+    size_type rest   = 0u;
+    root_            = take(root_, node_count, node_size_, extent_nodes(), memory, rest);
+    push_nodes(memory - rest * node_size_, rest);
+    capacity_ -= node_count;
+    return debug_fill_new(memory, n, 0);
 }
 
 void Memory_list::deallocate(void* ptr) noexcept {
-    auto node_next = static_cast<iterator>(debug_fill_free(ptr, node_size_, 0));
-
-    auto node = find_insert_position(Allocator_info{"salt::detail::Memory_list", this}, node_next,
-                                     memory_range{begin_node(), end_node()}, node_);
-    // Links new node between prev and next
-    list::xor_set_next(node_next, node.prev, node.next);
-    list::xor_exchange(node.prev, node.next, node_next);
-    list::xor_exchange(node.next, node.prev, node_next);
-    ++capacity_;
-
-    node_.prev = node.prev;
-    node_.next = node_next;
+    insert_impl(static_cast<iterator>(debug_fill_free(ptr, node_size_, 0)), 1u);
 }
 
 void Memory_list::deallocate(void* ptr, size_type n) noexcept {
-    if (n <= node_size_) {
+    if (n <= node_size_)
         deallocate(ptr);
-    } else {
-        auto memory = detail::debug_fill_free(ptr, n, 0);
-        auto prev   = insert_impl(memory, n);
+    else
+        insert_impl(static_cast<iterator>(debug_fill_free(ptr, n, 0)),
+                    (n + node_size_ - 1u) / node_size_);
+}
 
-        node_.prev = prev;
-        node_.next = static_cast<iterator>(memory);
-    }
+auto Memory_list::extent_count() const noexcept -> size_type {
+    return count_extents(root_);
 }
 
-auto Memory_list::insert_impl(void* memory, size_type size) noexcept -> iterator {
-    auto node_count = size / node_size_;
+void Memory_list::insert_impl(iterator memory, size_type node_count) noexcept {
     SALT_ASSERT(node_count > 0);
+#if SALT_MEMORY_DEBUG_DOUBLE_FREE
+    auto const end = memory + node_count * node_size_;
+    for (auto node = nodes_; node; node = list::get_next(node)) {
+        if (less_equal(memory, node) && less(node, end)) {
+            debug_check_double_free([] { return false; },
+                                    Allocator_info{"salt::detail::Memory_list", this}, memory);
+            return;
+        }
+    }
+#endif
+    if (insert_run(memory, node_count))
+        capacity_ += node_count;
+}
 
-    auto node = find_insert_position(Allocator_info{"salt::detail::Memory_list", this},
-                                     static_cast<iterator>(memory),
-                                     memory_range{begin_node(), end_node()}, node_);
-    list::xor_split_into_nodes(memory, node_size_, node_count, node);
-    capacity_ += node_count;
+bool Memory_list::insert_run(iterator memory, size_type node_count) noexcept {
+    auto const end    = memory + node_count * node_size_;
+    auto const end_of = [this](Free_extent* extent) {
+        return begin_of(extent) + extent->count * node_size_;
+    };
+
+    // Only the neighbours of the new nodes are merged with them.
+    auto [before, after] = split(root_, memory);
+    Free_extent* prev    = nullptr;
+    Free_extent* next    = nullptr;
+    if (before)
+        before = remove_last(before, prev);
+    if (after)
+        after = remove_first(after, next);
+
+    auto const overlaps =
+            (prev && greater(end_of(prev), memory)) || (next && greater(end, begin_of(next)));
+    if (overlaps) [[unlikely]] {
+        debug_check_double_free([] { return false; },
+                                Allocator_info{"salt::detail::Memory_list", this}, memory);
+        root_ = merge(merge(before, prev), merge(next, after));
+        return false;
+    }
 
-    if (node.prev == node_.prev)
-        node_.next = static_cast<iterator>(memory);
+    auto const merge_prev = prev && end_of(prev) == memory;
+    auto const merge_next = next && begin_of(next) == end;
+    if (!merge_prev && !merge_next && node_count < extent_nodes()) {
+        root_ = merge(merge(before, prev), merge(next, after));
+        push_nodes(memory, node_count);
+        return true;
+    }
 
-    return node.prev;
+    Free_extent* extent = nullptr;
+    if (merge_prev) {
+        extent = prev;
+        extent->count += node_count;
+    } else {
+        before = merge(before, prev);
+        extent = ::new (static_cast<void*>(memory)) Free_extent{nullptr, nullptr, node_count, 0u};
+    }
+    if (merge_next)
+        extent->count += next->count;
+    else
+        after = merge(next, after);
+
+    root_ = merge(merge(before, update(extent)), after);
+    return true;
 }
 
-auto Memory_list::begin_node() noexcept -> iterator {
-    void* begin = &proxy_.begin;
-    return static_cast<std::byte*>(begin);
+void Memory_list::push_nodes(iterator memory, size_type node_count) noexcept {
+    for (size_type i = 0u; i != node_count; ++i, memory += node_size_) {
+        list::set_next(memory, nodes_);
+        nodes_ = memory;
+    }
 }
 
-auto Memory_list::end_node() noexcept -> iterator {
-    void* end = &proxy_.end;
-    return static_cast<std::byte*>(end);
+void Memory_list::merge_nodes() noexcept {
+    size_type count = 0u;
+    for (auto node = nodes_; node; node = list::get_next(node))
+        ++count;
+    if (count == 0u)
+        return;
+
+    auto node = sort_nodes(nodes_, count);
+    SALT_ASSERT(!nodes_);
+    while (node) {
+        // The run of consecutive nodes starting at `node`.
+        auto const first      = node;
+        size_type  node_count = 1u;
+        for (node = list::get_next(node); node == first + node_count * node_size_;
+             node = list::get_next(node))
+            ++node_count;
+        insert_run(first, node_count);
+    }
 }
 
-} // namespace salt::detail
\ No newline at end of file
+} // namespace salt::detail
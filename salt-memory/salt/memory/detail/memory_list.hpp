@@ -1,10 +1,12 @@
 #pragma once
 #include <salt/memory/detail/align.hpp>
+#include <salt/memory/detail/allocation_bitmap.hpp>
 #include <salt/memory/detail/memory_ranges.hpp>
 
 namespace salt::detail {
 
-// Stores free blocks for a memory pool, memory blocks are fragmented and stored in a list.
+// Stores free blocks for a memory pool, memory blocks are fragmented and stored in a list. The
+// debug checks use an allocation bitmap, so a deallocation stays constant time with them enabled.
 struct [[nodiscard]] Unordered_memory_list final {
     using byte_type      = std::byte;
     using size_type      = std::size_t;
@@ -15,7 +17,7 @@ struct [[nodiscard]] Unordered_memory_list final {
 
     explicit Unordered_memory_list(size_type node_size) noexcept;
 
-    Unordered_memory_list(size_type node_size, void* memory, size_type size) noexcept;
+    Unordered_memory_list(size_type node_size, void* memory, size_type size);
 
     ~Unordered_memory_list() = default;
 
@@ -23,7 +25,9 @@ struct [[nodiscard]] Unordered_memory_list final {
 
     Unordered_memory_list& operator=(Unordered_memory_list&& other) noexcept;
 
-    void insert(void* memory, size_type size) noexcept;
+    // Inserts a region of free nodes. With the debug checks enabled it throws std::bad_alloc if the
+    // allocation bitmap can't grow, the list is unchanged then.
+    void insert(void* memory, size_type size);
 
     void* allocate() noexcept;
 
@@ -66,17 +70,35 @@ private:
     iterator  first_;
     size_type node_size_;
     size_type capacity_;
+
+    [[no_unique_address]] Debug_allocation_bitmap bitmap_;
+};
+
+// A run of consecutive free nodes of a Memory_list, it is stored in the first nodes of the run. The
+// extents form a treap ordered by address, the priority is a hash of the address, so it needs no
+// storage. Each extent knows the largest node count in its subtree, this finds a fitting extent in
+// logarithmic time.
+struct [[nodiscard]] Free_extent final {
+    Free_extent* left;
+    Free_extent* right;
+    std::size_t  count;
+    std::size_t  max_count;
 };
 
-// Stores free blocks for a memory pool, memory blocks are fragmented and stored in a list. Keeps
-// the nodes ordered this allows array allocations, that is, consecutive nodes.
+// Stores free blocks for a memory pool, consecutive free nodes are merged into extents which are
+// indexed by address. This allows array allocations, that is, consecutive nodes, and both the
+// allocation and deallocation of an array are logarithmic in the number of extents.
+// NOTE:
+//  * An array is allocated from the lowest addressed extent that fits, address-ordered first fit
+//    fragments about as little as best fit and needs only one index for searching and merging.
+//  * Nodes are only a pointer large. A run too small to hold a Free_extent is kept as single
+//    nodes in a list, which serves the node allocations first. The list is merged into the
+//    extents when an array does not fit, so its nodes are not lost for arrays.
 struct [[nodiscard]] Memory_list final {
     using byte_type      = std::byte;
     using size_type      = std::size_t;
     using iterator       = byte_type*;
     using const_iterator = byte_type const*;
-    using node_range     = Random_access_range<iterator>;
-    using memory_range   = Contiguous_range<iterator>;
 
     explicit Memory_list(size_type node_size) noexcept;
 
@@ -114,36 +136,51 @@ struct [[nodiscard]] Memory_list final {
         return capacity_;
     }
 
+    // The number of free extents, it is linear in the number of extents.
+    size_type extent_count() const noexcept;
+
+    // The node count of the largest free extent, so the largest array that can be allocated
+    // without merging the single nodes.
+    size_type max_extent() const noexcept {
+        return root_ ? root_->max_count : 0u;
+    }
+
     bool empty() const noexcept {
         return 0u == capacity_;
     }
 
     static constexpr auto min_size      = sizeof(byte_type*);
-    static constexpr auto min_alignment = alignof(byte_type*);
+    static constexpr auto min_alignment = alignof(Free_extent);
 
     static constexpr size_type min_block_size(size_type node_size, size_type node_count) noexcept {
         return (node_size < min_size ? min_size : node_size) * node_count;
     }
 
 private:
-    iterator insert_impl(void* memory, size_type size) noexcept;
+    // The number of nodes a run needs to hold a Free_extent.
+    size_type extent_nodes() const noexcept {
+        return (sizeof(Free_extent) + node_size_ - 1u) / node_size_;
+    }
 
-    iterator begin_node() noexcept;
-    iterator end_node() noexcept;
+    void insert_impl(iterator memory, size_type node_count) noexcept;
 
-    size_type node_size_;
-    size_type capacity_;
+    // Adds a run to the extents, merged with its neighbours, or to the single nodes if it is too
+    // small for an extent.
+    // It returns false if the run overlaps free nodes, i.e. it is a double free.
+    bool insert_run(iterator memory, size_type node_count) noexcept;
+
+    void push_nodes(iterator memory, size_type node_count) noexcept;
 
-    node_range  node_;
-    Proxy_range proxy_;
+    // Moves the single nodes into the extents, the consecutive ones are merged.
+    void merge_nodes() noexcept;
+
+    Free_extent* root_;
+    iterator     nodes_;
+    size_type    node_size_;
+    size_type    capacity_;
 };
 
-#if SALT_MEMORY_DEBUG_DOUBLE_FREE
-using Node_memory_list  = Memory_list;
-using Array_memory_list = Memory_list;
-#else
 using Node_memory_list  = Unordered_memory_list;
 using Array_memory_list = Memory_list;
-#endif
 
 } // namespace salt::detail
\ No newline at end of file
@@ -16,8 +16,8 @@ concept access_policy =
     };
 // clang-format on
 
-// An array of Memory_list types indexed via size, AccessPolicy does necessary conversions requires
-// trivial destructible MemoryList type.
+// An array of Memory_list types indexed via size, AccessPolicy does necessary conversions. The
+// lists are placed in the memory of the given stack, they are destroyed with the array.
 template <typename MemoryList, access_policy AccessPolicy>
 struct [[nodiscard]] Memory_list_array final {
     using access_policy_type = AccessPolicy;
@@ -40,7 +40,9 @@ struct [[nodiscard]] Memory_list_array final {
         }
     }
 
-    constexpr ~Memory_list_array() = default;
+    constexpr ~Memory_list_array() {
+        destroy();
+    }
 
     // clang-format off
     constexpr Memory_list_array(Memory_list_array&& other) noexcept
@@ -48,6 +50,7 @@ struct [[nodiscard]] Memory_list_array final {
               size_ {std::exchange(other.size_ , 0u     )} {}
 
     constexpr Memory_list_array& operator=(Memory_list_array&& other) noexcept {
+        destroy();
         array_ = std::exchange(other.array_, nullptr);
         size_  = std::exchange(other.size_ , 0u);
         return *this;
@@ -70,6 +73,12 @@ struct [[nodiscard]] Memory_list_array final {
     }
 
 private:
+    constexpr void destroy() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<memory_list>)
+            for (size_type i = 0u; i < size_; ++i)
+                std::destroy_at(array_ + i);
+    }
+
     static constexpr size_type min_size   =
             access_policy_type::index_from_size(memory_list::min_size);
 
@@ -19,10 +19,4 @@ struct [[nodiscard]] Contiguous_range final {
 };
 // clang-format on
 
-// A left-closed, right-open proxy range of memory where [begin, end).
-struct [[nodiscard]] Proxy_range final {
-    std::uintptr_t begin;
-    std::uintptr_t end;
-};
-
 } // namespace salt::detail
@@ -28,6 +28,23 @@ __asm__("mi_malloc")
 #endif
 ;
 
+#if defined(_MSC_VER) && !defined(SALT_CLANG)
+__declspec(dllimport)
+#elif __has_cpp_attribute(__gnu__::__dllimport__)
+[[__gnu__::__dllimport__]]
+#endif
+#if __has_cpp_attribute(__gnu__::__cdecl__)
+[[__gnu__::__cdecl__]]
+#endif
+#if __has_cpp_attribute(__gnu__::__malloc__)
+[[__gnu__::__malloc__]]
+#endif
+extern void* __cdecl mi_zalloc(std::size_t) noexcept
+#if defined(SALT_CLANG) || defined(SALT_GNUC)
+__asm__("mi_zalloc")
+#endif
+;
+
 #if defined(_MSC_VER) && !defined(SALT_CLANG)
 __declspec(dllimport)
 #elif __has_cpp_attribute(__gnu__::__dllimport__)
@@ -64,6 +81,16 @@ struct [[nodiscard]] Mimalloc_allocator final {
         return memory;
     }
 
+#if __has_cpp_attribute(__gnu__::__returns_nonnull__)
+    [[__gnu__::__returns_nonnull__]]
+#endif
+    static inline void* allocate_zeroed(size_type size, size_type) noexcept {
+        void* memory = mimalloc::mi_zalloc(size);
+        if (!memory)
+            salt::fast_terminate();
+        return memory;
+    }
+
     static inline void deallocate(void* memory, size_type, size_type) noexcept {
         mimalloc::mi_free(memory);
     }
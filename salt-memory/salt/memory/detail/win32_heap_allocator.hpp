@@ -76,6 +76,14 @@ struct [[nodiscard]] Win32_heap_allocator final {
         return win32_heapalloc_common_impl(size, 0u);
     }
 
+#if __has_cpp_attribute(__gnu__::__malloc__)
+    [[__gnu__::__malloc__]]
+#endif
+    static inline void* allocate_zeroed(size_type size, size_type) noexcept {
+        // HEAP_ZERO_MEMORY
+        return win32_heapalloc_common_impl(size, 0x00000008u);
+    }
+
     static inline void deallocate(void* memory, size_type, size_type) noexcept {
         if (!memory) [[unlikely]]
             return;
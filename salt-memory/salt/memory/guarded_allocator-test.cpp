@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/debugging.hpp>
+#include <salt/memory/guarded_allocator.hpp>
+#include <salt/memory/virtual_memory.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace salt;
+
+namespace {
+
+void const* invalid_pointer = nullptr;
+
+void record_invalid_pointer(Allocator_info const&, void const* ptr) {
+    invalid_pointer = ptr;
+}
+
+void const* overflow_memory = nullptr;
+std::size_t overflow_size   = 0u;
+void const* overflow_ptr    = nullptr;
+
+void record_overflow(void const* memory, std::size_t size, void const* ptr) {
+    overflow_memory = memory;
+    overflow_size   = size;
+    overflow_ptr    = ptr;
+}
+
+// Rejects the arrays whose size overflows, like a RawAllocator that checks its limits.
+struct [[nodiscard]] Array_checking_allocator {
+    using allocator_type  = Array_checking_allocator;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    void* allocate_node(std::size_t size, std::size_t) {
+        return ::operator new(size);
+    }
+
+    void* allocate_array(std::size_t count, std::size_t size, std::size_t alignment) {
+        if (count > std::numeric_limits<std::size_t>::max() / size)
+            throw std::bad_array_new_length{};
+        return allocate_node(count * size, alignment);
+    }
+
+    void deallocate_node(void* ptr, std::size_t, std::size_t) noexcept {
+        ::operator delete(ptr);
+    }
+};
+
+} // namespace
+
+TEST_CASE("salt::Sampled_guarded_allocator", "[salt-memory/guarded_allocator.hpp]") {
+    auto const page_size = virtual_memory_page_size();
+    auto const old_rate  = set_guarded_sample_rate(1u);
+    REQUIRE(get_guarded_sample_rate() == 1u);
+
+    Sampled_guarded_allocator<> allocator;
+
+    SECTION("sampled allocations are right-aligned to a guard page") {
+        auto ptr = static_cast<std::byte*>(allocator.allocate_node(13u, 1u));
+        REQUIRE(detail::guarded_range.contains(ptr));
+        REQUIRE(detail::is_aligned(ptr + 13u, page_size));
+        for (auto i = 0u; i != 13u; ++i)
+            ptr[i] = std::byte(i);
+        allocator.deallocate_node(ptr, 13u, 1u);
+
+        auto array = allocator.allocate_array(4u, 8u, 8u);
+        REQUIRE(detail::guarded_range.contains(array));
+        REQUIRE(detail::is_aligned(array, 8u));
+        allocator.deallocate_array(array, 4u, 8u, 8u);
+    }
+    SECTION("unsuitable allocations are forwarded") {
+        auto ptr = allocator.allocate_node(2u * page_size, 1u);
+        REQUIRE_FALSE(detail::guarded_range.contains(ptr));
+        allocator.deallocate_node(ptr, 2u * page_size, 1u);
+
+        set_guarded_sample_rate(0u);
+        ptr = allocator.allocate_node(16u, 8u);
+        REQUIRE_FALSE(detail::guarded_range.contains(ptr));
+        allocator.deallocate_node(ptr, 16u, 8u);
+    }
+    SECTION("arrays whose size overflows are forwarded") {
+        Sampled_guarded_allocator<Array_checking_allocator> checking;
+        auto const count = std::numeric_limits<std::size_t>::max() / 8u + 2u;
+        REQUIRE_THROWS_AS(checking.allocate_array(count, 16u, 8u), std::bad_array_new_length);
+    }
+    SECTION("invalid pointers are detected") {
+        auto const old_handler = set_invalid_pointer_handler(record_invalid_pointer);
+
+        auto ptr = static_cast<std::byte*>(allocator.allocate_node(32u, 8u));
+        allocator.deallocate_node(ptr + 8u, 32u, 8u);
+        REQUIRE(invalid_pointer == ptr + 8u);
+
+        allocator.deallocate_node(ptr, 32u, 8u);
+        invalid_pointer = nullptr;
+        allocator.deallocate_node(ptr, 32u, 8u);
+        REQUIRE(invalid_pointer == ptr);
+
+        set_invalid_pointer_handler(old_handler);
+    }
+    SECTION("faults are reported to the debug handlers") {
+        auto const old_invalid_handler  = set_invalid_pointer_handler(record_invalid_pointer);
+        auto const old_overflow_handler = set_buffer_overflow_handler(record_overflow);
+
+        auto ptr = static_cast<std::byte*>(allocator.allocate_node(16u, 1u));
+        REQUIRE(detail::guarded_report_fault(ptr + 16u));
+        REQUIRE(overflow_memory == ptr);
+        REQUIRE(overflow_size == 16u);
+        REQUIRE(overflow_ptr == ptr + 16u);
+
+        allocator.deallocate_node(ptr, 16u, 1u);
+        REQUIRE(detail::guarded_report_fault(ptr));
+        REQUIRE(invalid_pointer == ptr);
+
+        int value = 0;
+        REQUIRE_FALSE(detail::guarded_report_fault(&value));
+
+        set_buffer_overflow_handler(old_overflow_handler);
+        set_invalid_pointer_handler(old_invalid_handler);
+    }
+    SECTION("the first allocation of a thread is not always sampled") {
+        set_guarded_sample_rate(1u << 20u);
+
+        std::vector<void*> ptrs(32u);
+        for (auto& ptr : ptrs)
+            std::thread{[&] { ptr = allocator.allocate_node(16u, 8u); }}.join();
+        auto const sampled = std::ranges::count_if(
+                ptrs, [](void const* ptr) { return detail::guarded_range.contains(ptr); });
+        REQUIRE(sampled <= 1);
+
+        for (auto ptr : ptrs)
+            allocator.deallocate_node(ptr, 16u, 8u);
+    }
+
+    set_guarded_sample_rate(old_rate);
+}
@@ -0,0 +1,288 @@
+#include <salt/memory/guarded_allocator.hpp>
+
+#include <salt/memory/debugging.hpp>
+#include <salt/memory/detail/debug_helpers.hpp>
+#include <salt/memory/virtual_memory.hpp>
+
+#include <mutex>
+
+#if SALT_TARGET(WINDOWS)
+#    define WIN32_LEAN_AND_MEAN
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <signal.h>
+#endif
+
+namespace salt {
+
+namespace {
+
+std::atomic<std::uint32_t> internal_sample_rate(SALT_MEMORY_GUARDED_SAMPLE_RATE);
+
+// The countdown used while the sampling is disabled, so the threads notice a new rate eventually.
+constexpr std::uint32_t disabled_countdown = 1u << 16u;
+
+constexpr std::size_t guarded_slot_count = SALT_MEMORY_GUARDED_SLOT_COUNT;
+
+constinit thread_local std::uint32_t random_state = 0u;
+
+// Whether the countdown of the thread is a sampling interval, it is not before the first
+// allocation of the thread, after a rate change and while the sampling is disabled.
+constinit thread_local bool countdown_seeded = false;
+
+// A xorshift generator, good enough to randomize the sampling intervals.
+std::uint32_t guarded_random() noexcept {
+    auto state = random_state;
+    if (state == 0u) [[unlikely]] {
+        static std::atomic<std::uint32_t> seed(0x9E3779B9u);
+        state = seed.fetch_add(0x9E3779B9u, std::memory_order_relaxed) | 1u;
+    }
+    state ^= state << 13u;
+    state ^= state >> 17u;
+    state ^= state << 5u;
+    random_state = state;
+    return state;
+}
+
+struct [[nodiscard]] Guarded_slot final {
+    std::byte*  memory    = nullptr;
+    std::size_t size      = 0u;
+    bool        allocated = false;
+};
+
+// The process-wide pool of guarded slots. The reserved address range is laid out as
+// [guard][slot 0][guard][slot 1]...[guard], every slot and guard being a single page. Only the
+// pages of the allocated slots are committed, so any access to a guard page or a freed slot faults.
+class [[nodiscard]] Guarded_pool final {
+public:
+    void* allocate(std::size_t size, std::size_t alignment) noexcept {
+        auto const page_size = virtual_memory_page_size();
+        if (size == 0u || size > page_size || alignment > page_size)
+            return nullptr;
+
+        std::lock_guard lock{mutex_};
+        if (!pages_ && !reserve())
+            return nullptr;
+
+        auto const index = pop_slot();
+        if (index == guarded_slot_count)
+            return nullptr;
+
+        auto page = slot_page(index);
+        if (!virtual_memory_commit(page, 1u)) {
+            push_slot(index);
+            return nullptr;
+        }
+
+        // Place the memory at the end of the page, so an overflow hits the following guard page.
+        // The page itself is aligned, so aligning the offset is enough.
+        auto& slot     = slots_[index];
+        slot.memory    = page + ((page_size - size) & ~(alignment - 1u));
+        slot.size      = size;
+        slot.allocated = true;
+        return slot.memory;
+    }
+
+    void deallocate(void* ptr) noexcept {
+        {
+            std::lock_guard lock{mutex_};
+            auto const      index = slot_index(ptr);
+            if (index != guarded_slot_count && slots_[index].allocated &&
+                slots_[index].memory == ptr) {
+                slots_[index].allocated = false;
+                virtual_memory_decommit(slot_page(index), 1u);
+                push_slot(index);
+                return;
+            }
+        }
+        // Either a double free or a pointer that was never returned by the pool.
+        detail::debug_handle_invalid_ptr(info(), ptr);
+    }
+
+    // NOTE: It is called from a signal handler, the metadata is read without locking, which is good
+    // enough to diagnose the fault.
+    bool report_fault(void const* address) noexcept {
+        if (!detail::guarded_range.contains(address))
+            return false;
+
+        auto const page = std::size_t(reinterpret_cast<std::byte const*>(address) - pages_) /
+                          virtual_memory_page_size();
+        if (page % 2u == 1u) {
+            // An access to a slot that is not committed, i.e. a use-after-free.
+            detail::debug_handle_invalid_ptr(info(), const_cast<void*>(address));
+            return true;
+        }
+
+        // A guard page, prefer the overflow of the preceding slot over the underflow of the next.
+        auto const slot = page / 2u;
+        if (slot > 0u && slots_[slot - 1u].allocated)
+            get_buffer_overflow_handler()(slots_[slot - 1u].memory, slots_[slot - 1u].size,
+                                          address);
+        else if (slot < guarded_slot_count && slots_[slot].allocated)
+            get_buffer_overflow_handler()(slots_[slot].memory, slots_[slot].size, address);
+        else
+            detail::debug_handle_invalid_ptr(info(), const_cast<void*>(address));
+        return true;
+    }
+
+private:
+    static constexpr std::size_t no_pages = 2u * guarded_slot_count + 1u;
+
+    Allocator_info info() noexcept {
+        return {"salt::Sampled_guarded_allocator", this};
+    }
+
+    bool reserve() noexcept;
+
+    std::byte* slot_page(std::size_t index) const noexcept {
+        return pages_ + (2u * index + 1u) * virtual_memory_page_size();
+    }
+
+    // Returns guarded_slot_count if the pointer lies in a guard page.
+    std::size_t slot_index(void const* ptr) const noexcept {
+        auto const page = std::size_t(static_cast<std::byte const*>(ptr) - pages_) /
+                          virtual_memory_page_size();
+        return page % 2u == 1u ? page / 2u : guarded_slot_count;
+    }
+
+    // The never used slots are handed out first, afterwards the freed slots are reused in FIFO
+    // order, so they stay in quarantine as long as possible.
+    std::size_t pop_slot() noexcept {
+        if (unused_ != guarded_slot_count)
+            return unused_++;
+        if (quarantined_ == 0u)
+            return guarded_slot_count;
+
+        auto const index = quarantine_[head_];
+        head_            = (head_ + 1u) % guarded_slot_count;
+        --quarantined_;
+        return index;
+    }
+
+    void push_slot(std::size_t index) noexcept {
+        quarantine_[(head_ + quarantined_) % guarded_slot_count] = index;
+        ++quarantined_;
+    }
+
+    std::mutex   mutex_;
+    std::byte*   pages_ = nullptr;
+    Guarded_slot slots_[guarded_slot_count]{};
+    std::size_t  quarantine_[guarded_slot_count]{};
+    std::size_t  head_        = 0u;
+    std::size_t  quarantined_ = 0u;
+    std::size_t  unused_      = 0u;
+};
+
+constinit Guarded_pool guarded_pool{};
+
+#if SALT_TARGET(WINDOWS)
+long __stdcall guarded_exception_handler(EXCEPTION_POINTERS* exception) {
+    auto const record = exception->ExceptionRecord;
+    if (record->ExceptionCode == EXCEPTION_ACCESS_VIOLATION)
+        guarded_pool.report_fault(reinterpret_cast<void const*>(record->ExceptionInformation[1]));
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+void install_fault_handler() noexcept {
+    AddVectoredExceptionHandler(1u, guarded_exception_handler);
+}
+#else
+struct sigaction previous_segv_action;
+struct sigaction previous_bus_action;
+
+void guarded_signal_handler(int signal, siginfo_t* info, void* context) {
+    guarded_pool.report_fault(info->si_addr);
+
+    auto const& previous = signal == SIGSEGV ? previous_segv_action : previous_bus_action;
+    if (previous.sa_flags & SA_SIGINFO)
+        return previous.sa_sigaction(signal, info, context);
+    if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN)
+        return previous.sa_handler(signal);
+
+    // Restore the default action, the faulting access is executed again and terminates.
+    ::signal(signal, SIG_DFL);
+}
+
+void install_fault_handler() noexcept {
+    struct sigaction action {};
+    action.sa_sigaction = guarded_signal_handler;
+    action.sa_flags     = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGSEGV, &action, &previous_segv_action);
+    ::sigaction(SIGBUS, &action, &previous_bus_action);
+}
+#endif
+
+bool Guarded_pool::reserve() noexcept {
+    pages_ = static_cast<std::byte*>(virtual_memory_reserve(no_pages));
+    if (!pages_)
+        return false;
+
+    install_fault_handler();
+
+    auto const begin = reinterpret_cast<std::uintptr_t>(pages_);
+    detail::guarded_range.end.store(begin + no_pages * virtual_memory_page_size(),
+                                    std::memory_order_release);
+    detail::guarded_range.begin.store(begin, std::memory_order_release);
+    return true;
+}
+
+} // namespace
+
+std::uint32_t set_guarded_sample_rate(std::uint32_t rate) noexcept {
+    // Let the calling thread pick up the new rate immediately.
+    detail::guarded_countdown = 0u;
+    countdown_seeded          = false;
+    return internal_sample_rate.exchange(rate);
+}
+
+std::uint32_t get_guarded_sample_rate() noexcept {
+    return internal_sample_rate;
+}
+
+namespace detail {
+
+bool guarded_resample() noexcept {
+    auto const rate = std::uint64_t(internal_sample_rate.load(std::memory_order_relaxed));
+    if (rate == 0u) {
+        guarded_countdown = disabled_countdown;
+        countdown_seeded  = false;
+        return false;
+    }
+    // A random interval in [1, 2 * rate) keeps the average rate, but does not sample in lockstep
+    // with periodic allocation patterns.
+    auto const interval = [rate] {
+        return std::uint32_t(1u + guarded_random() % (2u * rate - 1u));
+    };
+    if (!countdown_seeded) {
+        // The first allocation is not sampled unconditionally, otherwise many short-lived threads
+        // would use up the slots and bias the sample towards the start of the threads.
+        countdown_seeded  = true;
+        guarded_countdown = interval();
+        if (guarded_countdown > 1u) {
+            --guarded_countdown;
+            return false;
+        }
+    }
+    guarded_countdown = interval();
+    return true;
+}
+
+void* guarded_allocate(std::size_t size, std::size_t alignment) noexcept {
+    return guarded_pool.allocate(size, alignment);
+}
+
+void guarded_deallocate(void* ptr) noexcept {
+    guarded_pool.deallocate(ptr);
+}
+
+bool guarded_report_fault(void const* address) noexcept {
+    return guarded_pool.report_fault(address);
+}
+
+} // namespace detail
+
+} // namespace salt
@@ -0,0 +1,137 @@
+#pragma once
+#include <salt/config.hpp>
+
+#include <salt/memory/allocator_traits.hpp>
+#include <salt/memory/default_allocator.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace salt {
+
+// Sets the sampling rate of the guarded allocators: on average every `rate`-th allocation of a
+// thread is served from a guard-page protected slot. A rate of 0 disables the sampling. It returns
+// the previous rate, the default is SALT_MEMORY_GUARDED_SAMPLE_RATE.
+std::uint32_t set_guarded_sample_rate(std::uint32_t rate) noexcept;
+
+std::uint32_t get_guarded_sample_rate() noexcept;
+
+namespace detail {
+
+// The address range of the process-wide guarded pool, it is empty until the first sampled
+// allocation reserves it.
+struct [[nodiscard]] Guarded_range final {
+    std::atomic<std::uintptr_t> begin{0u};
+    std::atomic<std::uintptr_t> end{0u};
+
+    bool contains(void const* ptr) const noexcept {
+        auto const address = reinterpret_cast<std::uintptr_t>(ptr);
+        return address >= begin.load(std::memory_order_acquire) &&
+               address < end.load(std::memory_order_acquire);
+    }
+};
+
+inline constinit Guarded_range guarded_range{};
+
+// The allocations of the thread until the next sampled one, it is 0 until the thread draws its
+// first sampling interval.
+inline constinit thread_local std::uint32_t guarded_countdown = 0u;
+
+// Draws the next sampling interval, returns whether the current allocation has to be guarded.
+bool guarded_resample() noexcept;
+
+inline bool guarded_sample() noexcept {
+    if (guarded_countdown > 1u) [[likely]] {
+        --guarded_countdown;
+        return false;
+    }
+    return guarded_resample();
+}
+
+// Returns nullptr if the allocation cannot be guarded, e.g. it is bigger than a page or all the
+// slots are in use.
+void* guarded_allocate(std::size_t size, std::size_t alignment) noexcept;
+
+void guarded_deallocate(void* ptr) noexcept;
+
+// Reports an access violation at the given address to the debug handlers, it is called by the
+// installed fault handler. It returns false if the address does not belong to the guarded pool.
+bool guarded_report_fault(void const* address) noexcept;
+
+} // namespace detail
+
+// A RawAllocator that serves a small random sample of the allocations from a pool of slots
+// surrounded by guard pages, everything else is forwarded to the given RawAllocator. The sampled
+// allocations are placed at the end of their page, so an overflow faults on the next guard page
+// and calls the buffer overflow handler, while freed slots stay inaccessible in a quarantine so a
+// use-after-free faults as well and calls the invalid pointer handler. Deallocating a pointer into
+// the pool that is not a live allocation (e.g. a double free) calls the invalid pointer handler.
+// NOTE:
+//  * The checks are cheap enough to stay enabled in release builds, their detection rate is
+//    controlled through `set_guarded_sample_rate`.
+//  * An overflow that stays inside the padding introduced by alignment is not detected.
+template <typename RawAllocator = Default_allocator>
+class [[nodiscard]] Sampled_guarded_allocator : allocator_traits<RawAllocator>::allocator_type {
+    using allocator_traits = allocator_traits<RawAllocator>;
+
+public:
+    using allocator_type  = typename allocator_traits::allocator_type;
+    using is_stateful     = typename allocator_traits::is_stateful;
+    using size_type       = typename allocator_traits::size_type;
+    using difference_type = typename allocator_traits::difference_type;
+
+    constexpr explicit Sampled_guarded_allocator(allocator_type allocator = allocator_type{})
+            : allocator_type{std::move(allocator)} {}
+
+    void* allocate_node(size_type size, size_type alignment) {
+        if (detail::guarded_sample())
+            if (auto memory = detail::guarded_allocate(size, alignment))
+                return memory;
+        return allocator_traits::allocate_node(allocator(), size, alignment);
+    }
+
+    // An array whose size overflows is forwarded, so the RawAllocator can report it.
+    void* allocate_array(size_type count, size_type size, size_type alignment) {
+        if (size != 0u && count <= std::numeric_limits<size_type>::max() / size &&
+            detail::guarded_sample())
+            if (auto memory = detail::guarded_allocate(count * size, alignment))
+                return memory;
+        return allocator_traits::allocate_array(allocator(), count, size, alignment);
+    }
+
+    void deallocate_node(void* node, size_type size, size_type alignment) noexcept {
+        if (detail::guarded_range.contains(node)) [[unlikely]]
+            return detail::guarded_deallocate(node);
+        allocator_traits::deallocate_node(allocator(), node, size, alignment);
+    }
+
+    void deallocate_array(void* array, size_type count, size_type size,
+                          size_type alignment) noexcept {
+        if (detail::guarded_range.contains(array)) [[unlikely]]
+            return detail::guarded_deallocate(array);
+        allocator_traits::deallocate_array(allocator(), array, count, size, alignment);
+    }
+
+    size_type max_node_size() const noexcept {
+        return allocator_traits::max_node_size(allocator());
+    }
+
+    size_type max_array_size() const noexcept {
+        return allocator_traits::max_array_size(allocator());
+    }
+
+    size_type max_alignment() const noexcept {
+        return allocator_traits::max_alignment(allocator());
+    }
+
+    constexpr allocator_type& allocator() noexcept {
+        return *this;
+    }
+
+    constexpr allocator_type const& allocator() const noexcept {
+        return *this;
+    }
+};
+
+} // namespace salt
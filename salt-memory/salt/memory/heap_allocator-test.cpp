@@ -1,6 +1,8 @@
 #include <catch2/catch.hpp>
+#include <algorithm>
 #include <vector>
 
+#include <salt/memory/allocator_traits.hpp>
 #include <salt/memory/detail/align.hpp>
 #include <salt/memory/detail/mimalloc_allocator.hpp>
 #include <salt/memory/heap_allocator.hpp>
@@ -35,4 +37,12 @@ void check_default_allocator(Allocator& allocator, std::size_t alignment = detai
 TEST_CASE("salt::Heap_allocator", "[salt-memory/heap_allocator.hpp]") {
     Heap_allocator allocator;
     check_default_allocator(allocator);
+
+    using traits = allocator_traits<Heap_allocator>;
+    for (std::size_t size : {1u, 64u, 4096u, 1u << 20u}) {
+        auto const memory =
+                static_cast<unsigned char*>(traits::allocate_zeroed_node(allocator, size, 1u));
+        REQUIRE(std::all_of(memory, memory + size, [](auto byte) { return byte == 0u; }));
+        traits::deallocate_node(allocator, memory, size, 1u);
+    }
 }
\ No newline at end of file
@@ -51,6 +51,21 @@ struct [[nodiscard]] Malloc_allocator final {
         return memory;
     }
 
+#    if __has_cpp_attribute(__gnu__::__returns_nonnull__)
+    [[__gnu__::__returns_nonnull__]]
+#    endif
+    static inline void* allocate_zeroed(size_type size, size_type) noexcept {
+        void* memory = 
+#    if __has_builtin(__builtin_calloc)
+        __builtin_calloc(1u, size);
+#    else
+        std::calloc(1u, size);
+#    endif
+        if (!memory)
+            salt::fast_terminate();
+        return memory;
+    }
+
     static inline void deallocate(void* memory, size_type, size_type) noexcept {
         if (!memory) [[unlikely]]
             return;
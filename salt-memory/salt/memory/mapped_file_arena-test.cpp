@@ -0,0 +1,87 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/detail/align.hpp>
+#include <salt/memory/mapped_file_arena.hpp>
+
+#include <fstream>
+#include <system_error>
+
+using namespace salt;
+
+namespace {
+
+struct [[nodiscard]] Table final {
+    explicit Table(Mapped_file_arena& arena) : keys{arena}, names{arena} {}
+
+    Mapped_vector<int>                keys;
+    Mapped_vector<Mapped_vector<char>> names;
+};
+
+} // namespace
+
+TEST_CASE("salt::Mapped_file_arena", "[salt-memory/mapped_file_arena.hpp]") {
+    auto const path = std::filesystem::temp_directory_path() / "salt-mapped_file_arena-test.bin";
+    std::filesystem::remove(path);
+
+    {
+        Mapped_file_arena arena(path, 1u);
+        REQUIRE(arena.created());
+        REQUIRE(arena.capacity() >= 4096u);
+        REQUIRE(arena.size() == sizeof(detail::Mapped_file_header));
+        REQUIRE(!arena.root<Table>());
+
+        auto table = arena.construct<Table>(arena);
+        arena.root(table);
+        for (auto i = 0; i != 100; ++i)
+            table->keys.push_back(i);
+        REQUIRE(table->keys.size() == 100u);
+        REQUIRE(table->keys.capacity() >= 100u);
+
+        for (auto name : {"first", "second"}) {
+            auto& chars = table->names.emplace_back(arena);
+            for (auto c = name; *c; ++c)
+                chars.push_back(*c);
+        }
+
+        SECTION("allocation") {
+            auto memory = arena.allocate_node(10u, 64u);
+            REQUIRE(detail::is_aligned(memory, 64u));
+
+            auto const marker = arena.top();
+            arena.allocate_array(10u, 4u, 1u);
+            REQUIRE(arena.top() == marker + 40u);
+            arena.unwind(marker);
+            REQUIRE(arena.top() == marker);
+
+            REQUIRE_THROWS_AS(arena.allocate_node(arena.capacity(), 1u), std::bad_alloc);
+        }
+    }
+
+    // The data structure is found again, most likely at another address.
+    {
+        Mapped_file_arena arena(path, 1u);
+        REQUIRE(!arena.created());
+
+        auto const table = arena.root<Table>();
+        REQUIRE(table);
+        REQUIRE(table->keys.size() == 100u);
+        for (auto i = 0; i != 100; ++i)
+            REQUIRE(table->keys[std::size_t(i)] == i);
+
+        REQUIRE(table->names.size() == 2u);
+        REQUIRE(std::string_view(table->names[0].data(), table->names[0].size()) == "first");
+        REQUIRE(std::string_view(table->names[1].data(), table->names[1].size()) == "second");
+
+        // Vectors can still grow.
+        table->keys.push_back(100);
+        REQUIRE(table->keys[100u] == 100);
+    }
+
+    SECTION("invalid file") {
+        std::filesystem::remove(path);
+        std::ofstream(path) << "not a mapped file arena";
+        REQUIRE_THROWS_AS(Mapped_file_arena(path, 1u), std::system_error);
+    }
+
+    std::filesystem::remove(path);
+}
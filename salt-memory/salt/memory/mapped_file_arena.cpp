@@ -0,0 +1,185 @@
+#include <salt/memory/mapped_file_arena.hpp>
+
+#include <salt/memory/detail/align.hpp>
+#include <salt/memory/virtual_memory.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#if SALT_TARGET(WINDOWS)
+#    define WIN32_LEAN_AND_MEAN
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace salt {
+
+namespace detail {
+
+void* mapped_file_allocate(Mapped_file_header& header, std::size_t size, std::size_t alignment) {
+    auto const top    = const_cast<std::byte*>(header.begin()) + header.size;
+    auto const offset = align_offset(top, alignment);
+    if (offset + size > header.capacity - header.size)
+        throw std::bad_alloc();
+
+    header.size += offset + size;
+    return top + offset;
+}
+
+bool mapped_file_expand(Mapped_file_header& header, void* memory, std::size_t old_size,
+                        std::size_t size) noexcept {
+    if (!header.is_top(memory, old_size) || size > header.capacity - header.size)
+        return false;
+
+    header.size += size;
+    return true;
+}
+
+} // namespace detail
+
+namespace {
+
+// "saltmapf" in little endian.
+constexpr std::uint64_t mapped_file_magic = 0x66'70'61'6D'74'6C'61'73u;
+
+[[noreturn]] void throw_system_error(int error, char const* what) {
+    throw std::system_error(error, std::system_category(), what);
+}
+
+#if SALT_TARGET(WINDOWS)
+// Maps the file and returns its size, `capacity` is the size of a new file.
+void* map_file(std::filesystem::path const& path, std::size_t& capacity, bool& created) {
+    auto const file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                                  nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw_system_error(int(GetLastError()), "salt::Mapped_file_arena: can't open the file");
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    created = size.QuadPart == 0;
+    if (!created)
+        capacity = std::size_t(size.QuadPart);
+
+    auto const mapping =
+            CreateFileMappingW(file, nullptr, PAGE_READWRITE, DWORD(std::uint64_t(capacity) >> 32u),
+                               DWORD(capacity & 0xFFFFFFFFu), nullptr);
+    auto const error = GetLastError();
+    CloseHandle(file);
+    if (!mapping)
+        throw_system_error(int(error), "salt::Mapped_file_arena: can't map the file");
+
+    auto const memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0u, 0u, capacity);
+    CloseHandle(mapping);
+    if (!memory)
+        throw_system_error(int(GetLastError()), "salt::Mapped_file_arena: can't map the file");
+    return memory;
+}
+
+void unmap_file(void* memory, std::size_t) noexcept {
+    UnmapViewOfFile(memory);
+}
+
+void flush_file(void* memory, std::size_t size) noexcept {
+    FlushViewOfFile(memory, size);
+}
+#else
+void* map_file(std::filesystem::path const& path, std::size_t& capacity, bool& created) {
+    auto const file = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (file == -1)
+        throw_system_error(errno, "salt::Mapped_file_arena: can't open the file");
+
+    struct stat status;
+    if (::fstat(file, &status) != 0) {
+        auto const error = errno;
+        ::close(file);
+        throw_system_error(error, "salt::Mapped_file_arena: can't open the file");
+    }
+
+    created = status.st_size == 0;
+    if (!created)
+        capacity = std::size_t(status.st_size);
+    else if (::ftruncate(file, off_t(capacity)) != 0) {
+        auto const error = errno;
+        ::close(file);
+        throw_system_error(error, "salt::Mapped_file_arena: can't resize the file");
+    }
+
+    // The mapping keeps the file open.
+    auto const memory = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    auto const error  = errno;
+    ::close(file);
+    if (memory == MAP_FAILED)
+        throw_system_error(error, "salt::Mapped_file_arena: can't map the file");
+    return memory;
+}
+
+void unmap_file(void* memory, std::size_t size) noexcept {
+    ::munmap(memory, size);
+}
+
+void flush_file(void* memory, std::size_t size) noexcept {
+    ::msync(memory, size, MS_SYNC);
+}
+#endif
+
+} // namespace
+
+Mapped_file_arena::Mapped_file_arena(std::filesystem::path const& path, size_type capacity) {
+    auto const page_size = virtual_memory_page_size();
+    capacity = std::max(capacity, sizeof(detail::Mapped_file_header) + 1u);
+    capacity = (capacity + page_size - 1u) / page_size * page_size;
+
+    auto const memory = map_file(path, capacity, created_);
+    if (created_) {
+        header_           = std::ranges::construct_at(static_cast<detail::Mapped_file_header*>(memory));
+        header_->magic    = mapped_file_magic;
+        header_->capacity = capacity;
+        header_->size     = sizeof(detail::Mapped_file_header);
+        return;
+    }
+
+    header_ = std::launder(static_cast<detail::Mapped_file_header*>(memory));
+    if (capacity < sizeof(detail::Mapped_file_header) || header_->magic != mapped_file_magic ||
+        header_->capacity != capacity || header_->size > capacity) {
+        unmap_file(memory, capacity);
+        header_ = nullptr;
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                "salt::Mapped_file_arena: the file is not a mapped file arena");
+    }
+}
+
+Mapped_file_arena::~Mapped_file_arena() {
+    if (!header_)
+        return;
+    auto const capacity = this->capacity();
+    flush();
+    unmap_file(header_, capacity);
+}
+
+Mapped_file_arena::Mapped_file_arena(Mapped_file_arena&& other) noexcept
+        : header_{std::exchange(other.header_, nullptr)}, created_{other.created_} {}
+
+Mapped_file_arena& Mapped_file_arena::operator=(Mapped_file_arena&& other) noexcept {
+    Mapped_file_arena tmp{std::move(other)};
+    std::swap(header_, tmp.header_);
+    std::swap(created_, tmp.created_);
+    return *this;
+}
+
+void Mapped_file_arena::flush() noexcept {
+    flush_file(header_, capacity());
+}
+
+Mapped_file_arena::size_type Mapped_file_arena::max_alignment() const noexcept {
+    return virtual_memory_page_size();
+}
+
+} // namespace salt
@@ -0,0 +1,297 @@
+#pragma once
+#include <salt/memory/offset_ptr.hpp>
+
+#include <salt/config.hpp>
+#include <salt/foundation/logger.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace salt {
+
+namespace detail {
+
+// The beginning of a mapped file, it holds the whole allocation state, so the containers inside of
+// the file can allocate without a reference to the Mapped_file_arena.
+struct [[nodiscard]] Mapped_file_header final {
+    std::uint64_t    magic;
+    std::uint64_t    capacity;
+    std::uint64_t    size;
+    Offset_ptr<void> root;
+
+    // Returns the top of the allocations, if `memory` ends there.
+    bool is_top(void const* memory, std::size_t size_bytes) const noexcept {
+        return static_cast<std::byte const*>(memory) + size_bytes == begin() + size;
+    }
+
+    std::byte const* begin() const noexcept {
+        return reinterpret_cast<std::byte const*>(this);
+    }
+};
+
+void* mapped_file_allocate(Mapped_file_header& header, std::size_t size, std::size_t alignment);
+
+// Grows the allocation at the top by `size` bytes in place, it returns false if it is not at the
+// top or there is not enough space left.
+bool mapped_file_expand(Mapped_file_header& header, void* memory, std::size_t old_size,
+                        std::size_t size) noexcept;
+
+} // namespace detail
+
+// A stateful RawAllocator that serves stack-like allocations out of a memory-mapped file. The file
+// keeps the allocations, so a data structure built in one run can be used in the next run by
+// mapping the file again, without parsing or rebuilding it. The data structure has to find its
+// parts with Offset_ptr and Mapped_vector instead of pointers and standard containers, since the
+// file is usually mapped at another address. Deallocation is not supported, like in a Memory_stack
+// it is only possible to unwind to a previously queried position.
+// NOTE:
+//  * The capacity of the file is fixed when it is created.
+//  * The objects inside of the file are never destroyed, they must be trivially destructible.
+//  * The file format is the memory layout of the objects, it is only portable between builds with
+//    the same ABI.
+class [[nodiscard]] Mapped_file_arena {
+public:
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_stateful     = std::true_type;
+    using marker          = std::uint64_t;
+
+    // Maps the file at `path`, it is created with the given capacity if it doesn't exist yet. The
+    // capacity is rounded up to a multiple of the page size. It throws std::system_error if the
+    // file can't be opened or is not a mapped file arena.
+    Mapped_file_arena(std::filesystem::path const& path, size_type capacity);
+
+    ~Mapped_file_arena();
+
+    Mapped_file_arena(Mapped_file_arena&& other) noexcept;
+
+    Mapped_file_arena& operator=(Mapped_file_arena&& other) noexcept;
+
+    // Returns true if the file was created, false if an existing file was mapped.
+    bool created() const noexcept {
+        return created_;
+    }
+
+    void* allocate_node(size_type size, size_type alignment) {
+        return detail::mapped_file_allocate(*header_, size, alignment);
+    }
+
+    void* allocate_array(size_type count, size_type size, size_type alignment) {
+        return allocate_node(count * size, alignment);
+    }
+
+    void deallocate_node(void*, size_type, size_type) noexcept {}
+
+    void deallocate_array(void*, size_type, size_type, size_type) noexcept {}
+
+    template <typename T, typename... Args> T* construct(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "Objects are never destroyed");
+        return std::ranges::construct_at(static_cast<T*>(allocate_node(sizeof(T), alignof(T))),
+                                         std::forward<Args>(args)...);
+    }
+
+    marker top() const noexcept {
+        return header_->size;
+    }
+
+    void unwind(marker stack_marker) noexcept {
+        SALT_ASSERT(stack_marker >= sizeof(detail::Mapped_file_header) &&
+                    stack_marker <= header_->size);
+        header_->size = stack_marker;
+    }
+
+    // The object found by `root<T>()` when the file is mapped again.
+    template <typename T> void root(T* object) noexcept {
+        header_->root = object;
+    }
+
+    template <typename T> T* root() const noexcept {
+        return static_cast<T*>(header_->root.get());
+    }
+
+    // Writes the changes back to the file, it is done anyway when the arena is destroyed.
+    void flush() noexcept;
+
+    size_type size() const noexcept {
+        return size_type(header_->size);
+    }
+
+    size_type capacity() const noexcept {
+        return size_type(header_->capacity);
+    }
+
+    size_type capacity_left() const noexcept {
+        return capacity() - size();
+    }
+
+    size_type max_node_size() const noexcept {
+        return capacity();
+    }
+
+    size_type max_array_size() const noexcept {
+        return capacity();
+    }
+
+    // The file is mapped at a page boundary, so larger alignments are not kept when it is mapped at
+    // another address.
+    size_type max_alignment() const noexcept;
+
+    detail::Mapped_file_header& header() const noexcept {
+        return *header_;
+    }
+
+private:
+    detail::Mapped_file_header* header_  = nullptr;
+    bool                        created_ = false;
+};
+
+// A vector inside of a Mapped_file_arena, it stays valid when the file is mapped again. It
+// allocates from the arena it was created with, growing a vector at the top of the arena is done in
+// place, otherwise the old elements are left behind as the arena can't deallocate them.
+template <typename T> class [[nodiscard]] Mapped_vector {
+    static_assert(std::is_trivially_destructible_v<T>, "Objects are never destroyed");
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator        = T*;
+    using const_iterator  = T const*;
+
+    explicit Mapped_vector(Mapped_file_arena& arena) noexcept : header_{&arena.header()} {}
+
+    Mapped_vector(Mapped_vector&& other) noexcept
+            : header_{other.header_}, data_{other.data_}, size_{std::exchange(other.size_, 0u)},
+              capacity_{std::exchange(other.capacity_, 0u)} {
+        other.data_ = nullptr;
+    }
+
+    Mapped_vector& operator=(Mapped_vector&& other) noexcept {
+        header_   = other.header_;
+        data_     = std::exchange(other.data_, nullptr);
+        size_     = std::exchange(other.size_, 0u);
+        capacity_ = std::exchange(other.capacity_, 0u);
+        return *this;
+    }
+
+    void reserve(size_type capacity) {
+        if (capacity <= capacity_)
+            return;
+
+        auto const data = data_.get();
+        if (data && detail::mapped_file_expand(*header_, data, capacity_ * sizeof(T),
+                                               (capacity - capacity_) * sizeof(T))) {
+            capacity_ = capacity;
+            return;
+        }
+
+        auto const memory = static_cast<T*>(
+                detail::mapped_file_allocate(*header_, capacity * sizeof(T), alignof(T)));
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (size_ != 0u)
+                std::memcpy(memory, data, size_ * sizeof(T));
+        } else {
+            for (size_type i = 0u; i != size_; ++i)
+                std::ranges::construct_at(memory + i, std::move(data[i]));
+        }
+        data_     = memory;
+        capacity_ = capacity;
+    }
+
+    template <typename... Args> T& emplace_back(Args&&... args) {
+        if (size_ == capacity_)
+            reserve(capacity_ == 0u ? 8u : capacity_ * 2u);
+        return *std::ranges::construct_at(data() + size_++, std::forward<Args>(args)...);
+    }
+
+    void push_back(T const& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        SALT_ASSERT(size_ != 0u);
+        --size_;
+    }
+
+    void resize(size_type size) {
+        reserve(size);
+        for (auto i = size_; i < size; ++i)
+            std::ranges::construct_at(data() + i);
+        size_ = size;
+    }
+
+    void clear() noexcept {
+        size_ = 0u;
+    }
+
+    T& operator[](size_type index) noexcept {
+        SALT_ASSERT(index < size_);
+        return data()[index];
+    }
+
+    T const& operator[](size_type index) const noexcept {
+        SALT_ASSERT(index < size_);
+        return data()[index];
+    }
+
+    T* data() noexcept {
+        return data_.get();
+    }
+
+    T const* data() const noexcept {
+        return data_.get();
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+
+    iterator end() noexcept {
+        return data() + size_;
+    }
+
+    const_iterator begin() const noexcept {
+        return data();
+    }
+
+    const_iterator end() const noexcept {
+        return data() + size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0u;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    operator std::span<T>() noexcept {
+        return {data(), size_};
+    }
+
+    operator std::span<T const>() const noexcept {
+        return {data(), size_};
+    }
+
+private:
+    Offset_ptr<detail::Mapped_file_header> header_;
+    Offset_ptr<T>                          data_;
+    size_type                              size_     = 0u;
+    size_type                              capacity_ = 0u;
+};
+
+} // namespace salt
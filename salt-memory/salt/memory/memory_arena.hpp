@@ -6,6 +6,7 @@
 #include <salt/memory/default_allocator.hpp>
 #include <salt/memory/detail/debug_helpers.hpp>
 #include <salt/memory/memory_block.hpp>
+#include <salt/memory/memory_pressure.hpp>
 
 namespace salt {
 
@@ -74,12 +75,20 @@ struct [[nodiscard]] Memory_block_stack final {
         auto* address = static_cast<std::byte const*>(ptr);
         for (auto* node = head_; node; node = node->prev) {
             auto* memory = static_cast<std::byte*>(static_cast<void*>(node));
-            if (address >= memory && address < memory + node->size)
+            if (address >= memory && address < memory + offset() + node->size)
                 return true;
         }
         return false;
     }
 
+    // Calls `function` with every block, from the top to the bottom.
+    template <typename Function> constexpr void for_each(Function function) const {
+        for (auto* node = head_; node; node = node->prev) {
+            void* memory = static_cast<void*>(node);
+            function(memory_block{static_cast<std::byte*>(memory) + offset(), node->size});
+        }
+    }
+
     static constexpr std::size_t offset() noexcept {
         // Node size rounded up to the next multiple of max_alignment.
         return (sizeof(Node) / max_alignment + (sizeof(Node) % max_alignment != 0)) * max_alignment;
@@ -94,32 +103,61 @@ private:
     Node* head_ = nullptr;
 };
 
-template <bool Cached> struct [[nodiscard]] Memory_arena_cache;
+template <bool Cached, std::size_t Nodes = 1u> struct [[nodiscard]] Memory_arena_cache;
+
+// The cached blocks are reported to the memory pressure registry, and given back on the next block
+// allocation or deallocation after the registry requested a trim, or when the owner calls
+// `serve_trim`. The blocks of each NUMA node are cached apart, a block is only reused on the node
+// it was allocated on.
+template <std::size_t Nodes> struct [[nodiscard]] Memory_arena_cache<enable_caching, Nodes> {
+    // The priority in the memory pressure registry, lower priorities are trimmed first.
+    void trim_priority(unsigned priority) noexcept {
+        entry_.priority(priority);
+    }
 
-template <> struct [[nodiscard]] Memory_arena_cache<enable_caching> {
 protected:
     constexpr std::size_t size() const noexcept {
-        return cache_.size();
+        std::size_t size = 0u;
+        for (auto const& cache : caches_)
+            size += cache.size();
+        return size;
     }
 
-    constexpr std::size_t block_size() const noexcept {
-        return cache_.top().size;
+    constexpr std::size_t block_size(std::size_t node) const noexcept {
+        return caches_[node].top().size;
     }
 
-    constexpr bool empty() const noexcept {
-        return cache_.empty();
+    constexpr bool empty(std::size_t node) const noexcept {
+        return caches_[node].empty();
     }
 
-    constexpr bool assign_block(Memory_block_stack& used) noexcept {
-        if (cache_.empty()) [[unlikely]]
+    template <typename BlockAllocator>
+    constexpr bool assign_block(BlockAllocator& allocator, Memory_block_stack& used,
+                                std::size_t node) noexcept {
+        serve_trim(allocator);
+        auto& cache = caches_[node];
+        if (cache.empty()) [[unlikely]]
             return false;
-        used.steal_top(cache_);
+        entry_.on_uncache(cache.top().size + Memory_block_stack::offset());
+        used.steal_top(cache);
         return true;
     }
 
     template <typename BlockAllocator>
-    constexpr void deallocate_block(BlockAllocator&, Memory_block_stack& used) noexcept {
-        cache_.steal_top(used);
+    constexpr void deallocate_block(BlockAllocator& allocator, Memory_block_stack& used,
+                                    std::size_t node) noexcept {
+        auto& cache = caches_[node];
+        cache.steal_top(used);
+        entry_.on_cache(cache.top().size + Memory_block_stack::offset());
+        serve_trim(allocator);
+    }
+
+    template <typename BlockAllocator>
+    constexpr bool serve_trim(BlockAllocator& allocator) noexcept {
+        if (!entry_.trim_requested()) [[likely]]
+            return false;
+        shrink_to_fit(allocator);
+        return true;
     }
 
     // clang-format off
@@ -127,8 +165,10 @@ protected:
     constexpr void shrink_to_fit(BlockAllocator& allocator) noexcept {
         Memory_block_stack to_deallocate;
         // Pop from cache and push to temporary stack
-        while (!cache_.empty())
-            to_deallocate.steal_top(cache_);
+        for (auto& cache : caches_)
+            while (!cache.empty())
+                to_deallocate.steal_top(cache);
+        entry_.on_trim();
         // Now deallocate everything
         while (!to_deallocate.empty())
             allocator.deallocate_block(to_deallocate.pop());
@@ -136,32 +176,41 @@ protected:
     // clang-format on
 
 private:
-    Memory_block_stack cache_;
+    Memory_block_stack    caches_[Nodes];
+    Memory_pressure_entry entry_{"salt::Memory_arena"};
 };
 
-template <> struct [[nodiscard]] Memory_arena_cache<disable_caching> {
+template <std::size_t Nodes> struct [[nodiscard]] Memory_arena_cache<disable_caching, Nodes> {
+    void trim_priority(unsigned) noexcept {}
+
 protected:
     constexpr std::size_t size() const noexcept {
         return 0u;
     }
 
-    constexpr std::size_t block_size() const noexcept {
+    constexpr std::size_t block_size(std::size_t) const noexcept {
         return 0u;
     }
 
-    constexpr bool empty() const noexcept {
+    constexpr bool empty(std::size_t) const noexcept {
         return true;
     }
 
-    constexpr bool assign_block(Memory_block_stack&) noexcept {
+    template <typename BlockAllocator>
+    constexpr bool assign_block(BlockAllocator&, Memory_block_stack&, std::size_t) noexcept {
         return false;
     }
 
     template <typename BlockAllocator>
-    constexpr void deallocate_block(BlockAllocator& allocator, Memory_block_stack& used) noexcept {
+    constexpr void deallocate_block(BlockAllocator& allocator, Memory_block_stack& used,
+                                    std::size_t) noexcept {
         allocator.deallocate_block(used.pop());
     }
 
+    template <typename BlockAllocator> constexpr bool serve_trim(BlockAllocator&) noexcept {
+        return false;
+    }
+
     // clang-format off
     template <typename BlockAllocator>
     constexpr void shrink_to_fit(BlockAllocator&) noexcept {}
@@ -182,6 +231,39 @@ concept block_allocator =
 template <typename Allocator>
 static constexpr inline bool is_block_allocator = block_allocator<Allocator>;
 
+// A BlockAllocator whose blocks are filled with zeros, e.g. because they are fresh pages of virtual
+// memory. It declares `using zeroed_blocks = std::true_type;`.
+// clang-format off
+template <typename Allocator>
+concept zeroing_block_allocator =
+    block_allocator<Allocator> and
+    requires { requires Allocator::zeroed_blocks::value; };
+// clang-format on
+
+// A BlockAllocator that places its blocks on NUMA nodes, e.g. the Numa_block_allocator. The cache
+// of a Memory_arena keeps the blocks of up to `max_nodes` nodes apart.
+// clang-format off
+template <typename Allocator>
+concept numa_block_allocator =
+    block_allocator<Allocator> and
+    requires(Allocator const& allocator, Memory_block block) {
+        { Allocator::max_nodes         } -> std::convertible_to<std::size_t>;
+        { allocator.current_node()     } -> std::same_as<std::size_t>;
+        { allocator.node_of(block)     } -> std::same_as<std::size_t>;
+    };
+// clang-format on
+
+namespace detail {
+
+template <typename BlockAllocator> constexpr std::size_t arena_cache_nodes() noexcept {
+    if constexpr (numa_block_allocator<BlockAllocator>)
+        return BlockAllocator::max_nodes;
+    else
+        return 1u;
+}
+
+} // namespace detail
+
 // A memory arena that manages huge memory blocks for a higher-level allocator. Some allocators
 // like Memory_stack work on huge memory blocks, this class manages them for those allocators. It
 // uses a BlockAllocator for the allocation of those blocks. The memory blocks in use are put onto
@@ -189,8 +271,11 @@ static constexpr inline bool is_block_allocator = block_allocator<Allocator>;
 // the last allocated block of the arena. By default, blocks are not really deallocated but stored
 // in a cache.
 template <block_allocator BlockAllocator, bool Cached = enable_caching>
-class [[nodiscard]] Memory_arena : BlockAllocator, detail::Memory_arena_cache<Cached> {
-    using memory_cache = detail::Memory_arena_cache<Cached>;
+class [[nodiscard]] Memory_arena
+        : BlockAllocator,
+          detail::Memory_arena_cache<Cached, detail::arena_cache_nodes<BlockAllocator>()> {
+    using memory_cache =
+            detail::Memory_arena_cache<Cached, detail::arena_cache_nodes<BlockAllocator>()>;
     using memory_block = Memory_block;
     using memory_stack = detail::Memory_block_stack;
 
@@ -223,8 +308,18 @@ public:
     }
 
     constexpr memory_block allocate_block() {
-        if (!memory_cache::assign_block(used_blocks_))
+        bool zeroed;
+        return allocate_block(zeroed);
+    }
+
+    // Allocates a block, `zeroed` tells whether it is known to be filled with zeros. That is only
+    // the case for a new block of a zeroing_block_allocator, not for a block from the cache.
+    constexpr memory_block allocate_block(bool& zeroed) {
+        zeroed = !memory_cache::assign_block(allocator(), used_blocks_, current_node());
+        if (zeroed)
             used_blocks_.push(allocator_type::allocate_block());
+        zeroed = zeroed && zeroing_block_allocator<allocator_type> &&
+                 !detail::debug_fill_enabled::value;
 
         auto block = used_blocks_.top();
         detail::debug_fill_internal(block.memory, block.size, false);
@@ -234,17 +329,31 @@ public:
     constexpr void deallocate_block() noexcept {
         auto block = used_blocks_.top();
         detail::debug_fill_internal(block.memory, block.size, true);
-        memory_cache::deallocate_block(allocator(), used_blocks_);
+        memory_cache::deallocate_block(allocator(), used_blocks_, node_of(block));
     }
 
     constexpr bool contains(void const* ptr) const noexcept {
         return used_blocks_.contains(ptr);
     }
 
+    // Calls `function` with every block in use, from the current block to the first one.
+    template <typename Function> constexpr void for_each_block(Function function) const {
+        used_blocks_.for_each(std::move(function));
+    }
+
     constexpr void shrink_to_fit() noexcept {
         memory_cache::shrink_to_fit(allocator());
     }
 
+    // Gives back the cache if the memory pressure registry requested a trim, it returns whether it
+    // did. A trim is otherwise served on the next block allocation or deallocation, so the owner
+    // of an arena that may stay idle calls this periodically, e.g. once per frame.
+    constexpr bool serve_trim() noexcept {
+        return memory_cache::serve_trim(allocator());
+    }
+
+    using memory_cache::trim_priority;
+
     constexpr size_type size() const noexcept {
         return used_blocks_.size();
     }
@@ -258,8 +367,9 @@ public:
     }
 
     constexpr size_type next_block_size() const noexcept {
-        return memory_cache::empty() ? allocator_type::block_size() - memory_stack::offset()
-                                     : memory_cache::block_size();
+        auto const node = current_node();
+        return memory_cache::empty(node) ? allocator_type::block_size() - memory_stack::offset()
+                                         : memory_cache::block_size(node);
     }
 
     constexpr allocator_type& allocator() noexcept {
@@ -271,6 +381,21 @@ public:
     }
 
 private:
+    // The cache of the calling thread, the one of its NUMA node.
+    constexpr size_type current_node() const noexcept {
+        if constexpr (numa_block_allocator<allocator_type>)
+            return allocator_type::current_node();
+        else
+            return 0u;
+    }
+
+    constexpr size_type node_of([[maybe_unused]] memory_block block) const noexcept {
+        if constexpr (numa_block_allocator<allocator_type>)
+            return allocator_type::node_of(block);
+        else
+            return 0u;
+    }
+
     memory_stack used_blocks_;
 };
 
@@ -2,9 +2,12 @@
 #include <salt/memory/detail/align.hpp>
 #include <salt/memory/detail/debug_helpers.hpp>
 
+#include <salt/memory/allocator_storage.hpp>
 #include <salt/memory/memory_arena.hpp>
 #include <salt/memory/memory_pool_type.hpp>
 
+#include <algorithm>
+
 namespace salt {
 
 namespace detail {
@@ -184,6 +187,23 @@ struct [[nodiscard]] allocator_traits<Memory_pool<PoolType, RawAllocator>> final
         return memory;
     }
 
+    static constexpr void*
+    allocate_zeroed_node(allocator_type& allocator,
+                         size_type       size     ,
+                         size_type       alignment)
+    {
+        return std::memset(allocate_node(allocator, size, alignment), 0, size);
+    }
+
+    static constexpr void*
+    allocate_zeroed_array(allocator_type& allocator,
+                          size_type       count    ,
+                          size_type       size     ,
+                          size_type       alignment)
+    {
+        return std::memset(allocate_array(allocator, count, size, alignment), 0, count * size);
+    }
+
     static constexpr void
     deallocate_node(allocator_type& allocator,
                     void*           node     ,
@@ -238,7 +258,10 @@ struct [[nodiscard]] composable_traits<Memory_pool<PoolType, BlockOrRawAllocator
         if (size      > allocator_traits::max_node_size(allocator) ||
             alignment > allocator_traits::max_alignment(allocator))
             return nullptr;
-        return allocator.try_allocate_node();
+        auto* memory = allocator.try_allocate_node();
+        if (memory)
+            allocator.on_allocate(size);
+        return memory;
     }
 
     static constexpr void*
@@ -253,7 +276,10 @@ struct [[nodiscard]] composable_traits<Memory_pool<PoolType, BlockOrRawAllocator
             count * size > allocator_traits::max_array_size(allocator) ||
             alignment    > allocator_traits::max_alignment (allocator))
             return nullptr;
-        return allocator.try_allocate_array(count, size);
+        auto* memory = allocator.try_allocate_array(count, size);
+        if (memory)
+            allocator.on_allocate(count * size);
+        return memory;
     }
 
     static constexpr bool
@@ -265,9 +291,11 @@ struct [[nodiscard]] composable_traits<Memory_pool<PoolType, BlockOrRawAllocator
         using allocator_traits = allocator_traits<allocator_type>;
 
         if (size      > allocator_traits::max_node_size(allocator) ||
-            alignment > allocator_traits::max_alignment(allocator))
+            alignment > allocator_traits::max_alignment(allocator) ||
+            !allocator.try_deallocate_node(node))
             return false;
-        return allocator.try_deallocate_node(node);
+        allocator.on_deallocate(size);
+        return true;
     }
 
     static constexpr bool
@@ -281,11 +309,144 @@ struct [[nodiscard]] composable_traits<Memory_pool<PoolType, BlockOrRawAllocator
 
         if (size         > allocator_traits::max_node_size (allocator) ||
             count * size > allocator_traits::max_array_size(allocator) ||
-            alignment    > allocator_traits::max_alignment (allocator))
+            alignment    > allocator_traits::max_alignment (allocator) ||
+            !allocator.try_deallocate_array(array, count, size))
             return false;
-        return allocator.try_deallocate_array(array, count, size);
+        allocator.on_deallocate(count * size);
+        return true;
     }
     // clang-format on
 };
 
-} // namespace salt
\ No newline at end of file
+// A shared RawAllocator for node containers. Allocations of up to `NodeSize` bytes come from a
+// Memory_pool of nodes of that size, the others, e.g. the bucket arrays of unordered containers,
+// from the RawAllocator of the pool. The copies share the pool, so the rebound allocators of a
+// container use the same pool and the container can be moved together with its nodes. The pool is
+// allocated with the Default_allocator and destroyed by the last copy.
+template <std::size_t NodeSize, typename RawAllocator = Default_allocator>
+class [[nodiscard]] Node_pool_allocator {
+    using allocator_traits = allocator_traits<RawAllocator>;
+    using memory_pool      = Memory_pool<Node_pool, RawAllocator>;
+    using pool_traits      = salt::allocator_traits<memory_pool>;
+    using state_traits     = salt::allocator_traits<Default_allocator>;
+
+    struct [[nodiscard]] State final {
+        memory_pool pool;
+        std::size_t references = 1u;
+    };
+
+public:
+    using allocator_type  = typename allocator_traits::allocator_type;
+    using size_type       = typename allocator_traits::size_type;
+    using difference_type = typename allocator_traits::difference_type;
+    using is_stateful     = std::true_type;
+
+    using propagate_on_container_swap            = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    static constexpr size_type node_size = std::max(NodeSize, memory_pool::min_node_size);
+
+    static constexpr size_type default_block_size = memory_pool::min_block_size(node_size, 64u);
+
+    explicit Node_pool_allocator(size_type      block_size = default_block_size,
+                                 allocator_type allocator  = allocator_type{}) {
+        Default_allocator state_allocator;
+        auto memory = state_traits::allocate_node(state_allocator, sizeof(State), alignof(State));
+        try {
+            state_ = std::ranges::construct_at(
+                    static_cast<State*>(memory),
+                    State{memory_pool{node_size, block_size, std::move(allocator)}});
+        } catch (...) {
+            state_traits::deallocate_node(state_allocator, memory, sizeof(State), alignof(State));
+            throw;
+        }
+    }
+
+    ~Node_pool_allocator() {
+        release();
+    }
+
+    Node_pool_allocator(Node_pool_allocator const& other) noexcept : state_{other.state_} {
+        ++state_->references;
+    }
+
+    Node_pool_allocator& operator=(Node_pool_allocator const& other) noexcept {
+        ++other.state_->references;
+        release();
+        state_ = other.state_;
+        return *this;
+    }
+
+    void* allocate_node(size_type size, size_type alignment) {
+        if (is_pooled(size, alignment))
+            return pool_traits::allocate_node(state_->pool, size, alignment);
+        return allocator_traits::allocate_node(allocator(), size, alignment);
+    }
+
+    void* allocate_array(size_type count, size_type size, size_type alignment) {
+        if (is_pooled(count * size, alignment))
+            return pool_traits::allocate_node(state_->pool, count * size, alignment);
+        return allocator_traits::allocate_array(allocator(), count, size, alignment);
+    }
+
+    void deallocate_node(void* node, size_type size, size_type alignment) noexcept {
+        if (is_pooled(size, alignment))
+            pool_traits::deallocate_node(state_->pool, node, size, alignment);
+        else
+            allocator_traits::deallocate_node(allocator(), node, size, alignment);
+    }
+
+    void deallocate_array(void* array, size_type count, size_type size,
+                          size_type alignment) noexcept {
+        if (is_pooled(count * size, alignment))
+            pool_traits::deallocate_node(state_->pool, array, count * size, alignment);
+        else
+            allocator_traits::deallocate_array(allocator(), array, count, size, alignment);
+    }
+
+    size_type max_node_size() const noexcept {
+        return allocator_traits::max_node_size(allocator());
+    }
+
+    size_type max_array_size() const noexcept {
+        return allocator_traits::max_array_size(allocator());
+    }
+
+    size_type max_alignment() const noexcept {
+        return allocator_traits::max_alignment(allocator());
+    }
+
+    allocator_type& allocator() const noexcept {
+        return state_->pool.allocator().allocator();
+    }
+
+    memory_pool const& pool() const noexcept {
+        return state_->pool;
+    }
+
+    friend bool operator==(Node_pool_allocator const& lhs,
+                           Node_pool_allocator const& rhs) noexcept {
+        return lhs.state_ == rhs.state_;
+    }
+
+private:
+    static constexpr bool is_pooled(size_type size, size_type alignment) noexcept {
+        return size <= node_size && alignment <= detail::alignment_for(node_size);
+    }
+
+    void release() noexcept {
+        if (--state_->references != 0u)
+            return;
+        std::ranges::destroy_at(state_);
+        Default_allocator state_allocator;
+        state_traits::deallocate_node(state_allocator, state_, sizeof(State), alignof(State));
+    }
+
+    State* state_;
+};
+
+template <std::size_t NodeSize, typename RawAllocator>
+struct [[nodiscard]] is_shared_allocator<Node_pool_allocator<NodeSize, RawAllocator>>
+        : std::true_type {};
+
+} // namespace salt
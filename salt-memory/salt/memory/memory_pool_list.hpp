@@ -7,6 +7,8 @@
 #include <salt/memory/memory_arena.hpp>
 #include <salt/memory/memory_pool_type.hpp>
 
+#include <new>
+
 namespace salt {
 
 namespace detail {
@@ -204,7 +206,7 @@ private:
         return static_cast<const_iterator>(block.memory) + block.size;
     }
 
-    constexpr bool fill(typename pool_type::type& pool) noexcept {
+    constexpr bool fill(typename pool_type::type& pool) {
         if (auto remaining = size_type(block_end() - stack_.top())) {
             auto offset = detail::align_offset(stack_.top(), detail::max_alignment);
             if (offset < remaining) {
@@ -217,11 +219,16 @@ private:
     }
 
     constexpr void try_reserve_memory(typename pool_type::type& pool, size_type capacity) noexcept {
-        auto* memory = stack_.allocate(block_end(), capacity, detail::max_alignment);
-        if (!memory)
-            fill(pool);
-        else
-            pool.insert(memory, capacity);
+        try {
+            auto* memory = stack_.allocate(block_end(), capacity, detail::max_alignment);
+            if (!memory)
+                fill(pool);
+            else
+                pool.insert(memory, capacity);
+        } catch (std::bad_alloc const&) {
+            // Only the allocation bitmap of the debug checks can fail, the pool stays empty and
+            // the memory is unused until the arena is released.
+        }
     }
 
     constexpr Memory_block reserve_memory(typename pool_type::type& pool, size_type capacity) {
@@ -0,0 +1,98 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/memory_arena.hpp>
+#include <salt/memory/memory_pressure.hpp>
+
+#include <algorithm>
+
+using namespace salt;
+
+namespace {
+
+using memory_arena = Memory_arena<Growing_block_allocator<>>;
+
+// The registry reports the address of the cache inside of the arena.
+std::size_t reclaimable(memory_arena const& arena) {
+    auto const begin  = reinterpret_cast<std::byte const*>(&arena);
+    auto const report = memory_pressure_report();
+    auto const it     = std::ranges::find_if(report, [&](auto const& entry) {
+        auto const address = static_cast<std::byte const*>(entry.info.allocator);
+        return address >= begin && address < begin + sizeof(memory_arena);
+    });
+    return it == report.end() ? std::size_t(-1) : it->size;
+}
+
+} // namespace
+
+TEST_CASE("salt::memory_pressure", "[salt-memory/memory_pressure.hpp]") {
+    memory_arena arena(1024u);
+    REQUIRE(reclaimable(arena) == 0u);
+
+    [[maybe_unused]] auto block1 = arena.allocate_block();
+    [[maybe_unused]] auto block2 = arena.allocate_block();
+    arena.deallocate_block();
+    auto const cached = reclaimable(arena);
+    REQUIRE(cached >= 2048u);
+    REQUIRE(reclaimable_memory() >= cached);
+
+    SECTION("assign a cached block") {
+        [[maybe_unused]] auto block3 = arena.allocate_block();
+        REQUIRE(reclaimable(arena) == 0u);
+    }
+    SECTION("shrink_to_fit") {
+        arena.shrink_to_fit();
+        REQUIRE(reclaimable(arena) == 0u);
+    }
+    SECTION("trim is served on the next block deallocation") {
+        memory_arena other(1024u);
+        other.trim_priority(unsigned(-1));
+        [[maybe_unused]] auto block3 = other.allocate_block();
+        other.deallocate_block();
+
+        // The arenas with a lower priority are trimmed first.
+        auto const lower = reclaimable_memory() - reclaimable(other);
+        REQUIRE(trim_memory(lower) == lower);
+        REQUIRE(arena.cache_size() == 1u);
+
+        arena.deallocate_block();
+        REQUIRE(arena.cache_size() == 0u);
+        REQUIRE(reclaimable(arena) == 0u);
+
+        block3 = other.allocate_block();
+        other.deallocate_block();
+        REQUIRE(other.cache_size() == 1u);
+    }
+    SECTION("trim is served on the next block allocation") {
+        REQUIRE(trim_memory() >= cached);
+        auto const block3 = arena.allocate_block();
+        REQUIRE(block3.size > block2.size);
+        REQUIRE(arena.cache_size() == 0u);
+        REQUIRE(reclaimable(arena) == 0u);
+    }
+    SECTION("serve_trim") {
+        REQUIRE_FALSE(arena.serve_trim());
+        REQUIRE(arena.cache_size() == 1u);
+
+        REQUIRE(trim_memory() >= cached);
+        REQUIRE(arena.serve_trim());
+        REQUIRE(arena.cache_size() == 0u);
+        REQUIRE(reclaimable(arena) == 0u);
+        REQUIRE_FALSE(arena.serve_trim());
+    }
+    SECTION("move") {
+        memory_arena other(std::move(arena));
+        REQUIRE(reclaimable(other) == cached);
+        REQUIRE(reclaimable(arena) == 0u);
+    }
+}
+
+TEST_CASE("salt::memory_usage", "[salt-memory/memory_pressure.hpp]") {
+    auto const usage = memory_usage();
+#if SALT_TARGET(LINUX)
+    REQUIRE(usage.resident > 0u);
+#endif
+    REQUIRE((usage.limit == 0u || poll_memory_pressure(1.0) <= reclaimable_memory()));
+
+    // The monitor thread is stopped by the destructor.
+    Memory_pressure_monitor monitor{std::chrono::milliseconds{1}};
+}
@@ -0,0 +1,257 @@
+#include <salt/memory/memory_pressure.hpp>
+
+#include <salt/config.hpp>
+#include <salt/memory/virtual_memory.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <optional>
+
+#if SALT_TARGET(WINDOWS)
+#    define WIN32_LEAN_AND_MEAN
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#    include <psapi.h>
+#elif SALT_TARGET(APPLE)
+#    include <mach/mach.h>
+#endif
+
+namespace salt {
+
+namespace detail {
+
+struct [[nodiscard]] Memory_pressure_registry final {
+    // Returns the registered entries ordered by their priority, the mutex must be locked as long as
+    // they are used.
+    static std::vector<Memory_pressure_entry*> entries() {
+        std::vector<Memory_pressure_entry*> result;
+        for (auto entry = head; entry; entry = entry->next_)
+            result.push_back(entry);
+        std::ranges::stable_sort(result, {}, [](auto entry) { return entry->priority(); });
+        return result;
+    }
+
+    // Calls `visit(entry)` for the entries in the order of `entries` until it returns false. It
+    // does not allocate, so it can run under memory pressure. The mutex must be locked.
+    template <typename Visit> static void visit_by_priority(Visit visit) noexcept {
+        for (std::optional<unsigned> level; (level = next_priority(level));)
+            for (auto entry = head; entry; entry = entry->next_)
+                if (entry->priority() == *level && !visit(*entry))
+                    return;
+    }
+
+    // Returns the lowest priority above `after`, the mutex must be locked.
+    static std::optional<unsigned> next_priority(std::optional<unsigned> after) noexcept {
+        std::optional<unsigned> next;
+        for (auto entry = head; entry; entry = entry->next_) {
+            auto const priority = entry->priority();
+            if ((!after || priority > *after) && (!next || priority < *next))
+                next = priority;
+        }
+        return next;
+    }
+
+    // Returns the reclaimable memory of all entries, the mutex must be locked.
+    static std::size_t total() noexcept {
+        std::size_t size = 0u;
+        for (auto entry = head; entry; entry = entry->next_)
+            size += entry->reclaimable_.load(std::memory_order_relaxed);
+        return size;
+    }
+
+    static auto report(Memory_pressure_entry const& entry) noexcept {
+        return Reclaimable_memory{{entry.name_, &entry},
+                                  entry.priority(),
+                                  entry.reclaimable_.load(std::memory_order_relaxed)};
+    }
+
+    static void request_trim(Memory_pressure_entry& entry) noexcept {
+        entry.trim_requested_.store(true, std::memory_order_release);
+    }
+
+    static constinit inline std::mutex             mutex{};
+    static constinit inline Memory_pressure_entry* head = nullptr;
+};
+
+Memory_pressure_entry::Memory_pressure_entry(std::string_view name) noexcept : name_{name} {
+    link();
+}
+
+Memory_pressure_entry::~Memory_pressure_entry() {
+    unlink();
+}
+
+Memory_pressure_entry::Memory_pressure_entry(Memory_pressure_entry&& other) noexcept
+        : name_{other.name_} {
+    reclaimable_.store(other.reclaimable_.exchange(0u, std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    priority(other.priority());
+    link();
+}
+
+Memory_pressure_entry& Memory_pressure_entry::operator=(Memory_pressure_entry&& other) noexcept {
+    name_ = other.name_;
+    reclaimable_.store(other.reclaimable_.exchange(0u, std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    priority(other.priority());
+    return *this;
+}
+
+void Memory_pressure_entry::link() noexcept {
+    std::lock_guard lock{Memory_pressure_registry::mutex};
+    next_ = Memory_pressure_registry::head;
+    if (next_)
+        next_->prev_ = this;
+    Memory_pressure_registry::head = this;
+}
+
+void Memory_pressure_entry::unlink() noexcept {
+    std::lock_guard lock{Memory_pressure_registry::mutex};
+    if (prev_)
+        prev_->next_ = next_;
+    else
+        Memory_pressure_registry::head = next_;
+    if (next_)
+        next_->prev_ = prev_;
+}
+
+} // namespace detail
+
+namespace {
+
+#if SALT_TARGET(LINUX)
+// Reads the first number of a file, "max" and unreadable files are 0.
+std::size_t read_size(char const* path) noexcept {
+    auto file = std::fopen(path, "r");
+    if (!file)
+        return 0u;
+
+    unsigned long long value = 0u;
+    if (std::fscanf(file, "%llu", &value) != 1)
+        value = 0u;
+    std::fclose(file);
+    return std::size_t(value);
+}
+
+// Reads the path of the cgroup v2 hierarchy of the process, e.g. "/user.slice".
+bool read_cgroup(char* path, std::size_t size) noexcept {
+    auto file = std::fopen("/proc/self/cgroup", "r");
+    if (!file)
+        return false;
+
+    auto found = false;
+    char line[512];
+    while (!found && std::fgets(line, sizeof(line), file)) {
+        if (std::strncmp(line, "0::", 3u) != 0)
+            continue;
+        line[std::strcspn(line, "\n")] = '\0';
+        found = std::snprintf(path, size, "/sys/fs/cgroup%s", line + 3) < int(size);
+    }
+    std::fclose(file);
+    return found;
+}
+#endif
+
+} // namespace
+
+Memory_usage memory_usage() noexcept {
+    auto usage = Memory_usage{0u, 0u, 0u};
+#if SALT_TARGET(LINUX)
+    if (auto file = std::fopen("/proc/self/statm", "r")) {
+        unsigned long long size = 0u, resident = 0u;
+        if (std::fscanf(file, "%llu %llu", &size, &resident) == 2)
+            usage.resident = std::size_t(resident) * virtual_memory_page_size();
+        std::fclose(file);
+    }
+
+    char cgroup[384];
+    char path[512];
+    if (read_cgroup(cgroup, sizeof(cgroup))) {
+        std::snprintf(path, sizeof(path), "%s/memory.current", cgroup);
+        usage.current = read_size(path);
+        std::snprintf(path, sizeof(path), "%s/memory.max", cgroup);
+        usage.limit = read_size(path);
+    }
+    if (usage.current == 0u) {
+        // The cgroup v1 hierarchy, an unlimited cgroup reports a huge page-aligned limit.
+        usage.current = read_size("/sys/fs/cgroup/memory/memory.usage_in_bytes");
+        usage.limit   = read_size("/sys/fs/cgroup/memory/memory.limit_in_bytes");
+        if (usage.limit >= std::size_t(1u) << 60u)
+            usage.limit = 0u;
+    }
+#elif SALT_TARGET(WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        usage.resident = counters.WorkingSetSize;
+        usage.current  = counters.PagefileUsage;
+    }
+#elif SALT_TARGET(APPLE)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t      count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, task_info_t(&info), &count) ==
+        KERN_SUCCESS)
+        usage.resident = usage.current = info.resident_size;
+#endif
+    return usage;
+}
+
+std::vector<Reclaimable_memory> memory_pressure_report() {
+    using registry = detail::Memory_pressure_registry;
+
+    std::vector<Reclaimable_memory> report;
+    std::lock_guard                 lock{registry::mutex};
+    for (auto entry : registry::entries())
+        report.push_back(registry::report(*entry));
+    return report;
+}
+
+std::size_t reclaimable_memory() noexcept {
+    using registry = detail::Memory_pressure_registry;
+
+    std::lock_guard lock{registry::mutex};
+    return registry::total();
+}
+
+std::size_t trim_memory(std::size_t size) noexcept {
+    using registry = detail::Memory_pressure_registry;
+
+    std::size_t     requested = 0u;
+    std::lock_guard lock{registry::mutex};
+    registry::visit_by_priority([&](detail::Memory_pressure_entry& entry) {
+        if (requested >= size)
+            return false;
+        auto const reclaimable = registry::report(entry).size;
+        if (reclaimable != 0u) {
+            registry::request_trim(entry);
+            requested += reclaimable;
+        }
+        return true;
+    });
+    return requested;
+}
+
+std::size_t poll_memory_pressure(double threshold) noexcept {
+    auto const usage = memory_usage();
+    if (usage.limit == 0u)
+        return 0u;
+
+    auto const allowed = std::size_t(double(usage.limit) * threshold);
+    return usage.current > allowed ? trim_memory(usage.current - allowed) : 0u;
+}
+
+Memory_pressure_monitor::Memory_pressure_monitor(std::chrono::milliseconds interval,
+                                                 double                    threshold)
+        : thread_{[interval, threshold](std::stop_token token) {
+              std::mutex                  mutex;
+              std::condition_variable_any condition;
+              std::unique_lock            lock{mutex};
+              while (!condition.wait_for(lock, token, interval, [&] { return token.stop_requested(); }))
+                  poll_memory_pressure(threshold);
+          }} {}
+
+} // namespace salt
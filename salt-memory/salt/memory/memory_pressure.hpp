@@ -0,0 +1,123 @@
+#pragma once
+#include <salt/memory/debugging.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace salt {
+
+namespace detail {
+
+// A member of the process-wide memory pressure registry, the constructor registers it and the
+// destructor removes it. The owner publishes the amount of memory it could give back and polls for
+// trim requests, the registry never touches the owner directly. This keeps an allocator that is
+// used by a single thread free of synchronization.
+class [[nodiscard]] Memory_pressure_entry {
+public:
+    explicit Memory_pressure_entry(std::string_view name) noexcept;
+
+    ~Memory_pressure_entry();
+
+    Memory_pressure_entry(Memory_pressure_entry&& other) noexcept;
+
+    Memory_pressure_entry& operator=(Memory_pressure_entry&& other) noexcept;
+
+    void on_cache(std::size_t size) noexcept {
+        reclaimable_.store(reclaimable_.load(std::memory_order_relaxed) + size,
+                           std::memory_order_relaxed);
+    }
+
+    void on_uncache(std::size_t size) noexcept {
+        reclaimable_.store(reclaimable_.load(std::memory_order_relaxed) - size,
+                           std::memory_order_relaxed);
+    }
+
+    void on_trim() noexcept {
+        reclaimable_.store(0u, std::memory_order_relaxed);
+    }
+
+    // Returns true once after the registry requested a trim.
+    bool trim_requested() noexcept {
+        return trim_requested_.load(std::memory_order_relaxed) &&
+               trim_requested_.exchange(false, std::memory_order_acquire);
+    }
+
+    void priority(unsigned priority) noexcept {
+        priority_.store(priority, std::memory_order_relaxed);
+    }
+
+    unsigned priority() const noexcept {
+        return priority_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void link() noexcept;
+    void unlink() noexcept;
+
+    Memory_pressure_entry*   prev_ = nullptr;
+    Memory_pressure_entry*   next_ = nullptr;
+    std::string_view         name_;
+    std::atomic<std::size_t> reclaimable_{0u};
+    std::atomic<unsigned>    priority_{0u};
+    std::atomic<bool>        trim_requested_{false};
+
+    friend struct Memory_pressure_registry;
+};
+
+} // namespace detail
+
+// The memory usage of the process in bytes, a value is 0 if it is unknown on the platform. The
+// current usage and the limit are taken from the cgroup of the process, if there is one.
+struct [[nodiscard]] Memory_usage final {
+    std::size_t resident;
+    std::size_t current;
+    std::size_t limit;
+};
+
+Memory_usage memory_usage() noexcept;
+
+// The memory a registered allocator holds in its cache and could give back.
+struct [[nodiscard]] Reclaimable_memory final {
+    Allocator_info info;
+    unsigned       priority;
+    std::size_t    size;
+};
+
+// Returns the reclaimable memory of every registered allocator, in trim order.
+std::vector<Reclaimable_memory> memory_pressure_report();
+
+// Returns the total reclaimable memory of the registered allocators.
+std::size_t reclaimable_memory() noexcept;
+
+// Requests the registered allocators to give back their caches, the ones with the lowest priority
+// first, until at least `size` bytes are covered. It returns the number of requested bytes.
+// NOTE:
+//  The request is served by each allocator on its next block allocation or deallocation, or when
+//  its owner calls `serve_trim`, not immediately.
+//  It does not allocate, so it can be called when the memory is exhausted.
+std::size_t trim_memory(std::size_t size = std::size_t(-1)) noexcept;
+
+static constexpr inline double default_memory_pressure_threshold = 0.9;
+
+// Compares the current memory usage with the limit and trims the excess above
+// `threshold * limit`. It returns the number of requested bytes, nothing is done without a limit.
+std::size_t poll_memory_pressure(double threshold = default_memory_pressure_threshold) noexcept;
+
+// Calls `poll_memory_pressure` periodically from a background thread, as long as it is alive.
+class [[nodiscard]] Memory_pressure_monitor {
+public:
+    explicit Memory_pressure_monitor(std::chrono::milliseconds interval,
+                                     double threshold = default_memory_pressure_threshold);
+
+    ~Memory_pressure_monitor() = default;
+
+    Memory_pressure_monitor(Memory_pressure_monitor&&) = delete;
+    Memory_pressure_monitor& operator=(Memory_pressure_monitor&&) = delete;
+
+private:
+    std::jthread thread_;
+};
+
+} // namespace salt
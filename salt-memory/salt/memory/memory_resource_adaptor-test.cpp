@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/containers.hpp>
+#include <salt/memory/heap_allocator.hpp>
+#include <salt/memory/memory_pool.hpp>
+#include <salt/memory/memory_resource_adaptor.hpp>
+#include <salt/memory/memory_stack.hpp>
+
+#include <list>
+#include <vector>
+
+using namespace salt;
+
+TEST_CASE("salt::Memory_resource_adaptor", "[salt-memory/memory_resource_adaptor.hpp]") {
+    SECTION("stateful allocator") {
+        Memory_stack<>          stack{4096u};
+        Memory_resource_adaptor resource{stack};
+        REQUIRE(&resource.allocator() == &stack);
+
+        auto const marker = stack.top();
+        {
+            std::pmr::vector<int> vector{&resource};
+            for (auto i = 0; i != 1000; ++i)
+                vector.push_back(i);
+            REQUIRE(vector.size() == 1000u);
+            REQUIRE(vector.back() == 999);
+        }
+        stack.unwind(marker);
+
+        Memory_resource_adaptor same{stack};
+        REQUIRE(resource == same);
+
+        Memory_stack<>          other_stack{4096u};
+        Memory_resource_adaptor other{other_stack};
+        REQUIRE(resource != other);
+        REQUIRE(resource != *std::pmr::new_delete_resource());
+    }
+    SECTION("node allocator") {
+        Memory_pool<>           pool{32u, 4096u};
+        Memory_resource_adaptor resource{pool};
+
+        auto const capacity = pool.capacity();
+
+        std::pmr::list<int> list{&resource};
+        for (auto i = 0; i != 100; ++i)
+            list.push_back(i);
+        REQUIRE(list.size() == 100u);
+        REQUIRE(pool.capacity() < capacity);
+
+        list.clear();
+        REQUIRE(pool.capacity() == capacity);
+    }
+    SECTION("stateless allocator") {
+        Memory_resource_adaptor resource{Heap_allocator{}};
+        Memory_resource_adaptor other{Heap_allocator{}};
+        REQUIRE(resource == other);
+
+        auto const memory = resource.allocate(64u, 16u);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(memory) % 16u == 0u);
+        other.deallocate(memory, 64u, 16u);
+    }
+}
+
+TEST_CASE("salt::Memory_resource_allocator", "[salt-memory/memory_resource_adaptor.hpp]") {
+    std::byte                           buffer[1024];
+    std::pmr::monotonic_buffer_resource resource{buffer, sizeof(buffer),
+                                                 std::pmr::null_memory_resource()};
+
+    Memory_resource_allocator allocator{&resource};
+    REQUIRE(allocator.resource() == &resource);
+    REQUIRE(allocator == Memory_resource_allocator{&resource});
+    REQUIRE(allocator != Memory_resource_allocator{});
+
+    memory::vector<int, Memory_resource_allocator> vector{allocator};
+    vector.reserve(16u);
+    for (auto i = 0; i != 16; ++i)
+        vector.push_back(i);
+    REQUIRE(vector.size() == 16u);
+    REQUIRE(static_cast<void*>(vector.data()) >= static_cast<void*>(buffer));
+    REQUIRE(static_cast<void*>(vector.data()) < static_cast<void*>(buffer + sizeof(buffer)));
+
+    auto reference = make_allocator_reference(allocator);
+    REQUIRE(reference.allocator() == allocator);
+    REQUIRE_THROWS_AS(reference.allocate_node(2048u, 8u), std::bad_alloc);
+}
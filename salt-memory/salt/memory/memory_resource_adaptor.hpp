@@ -0,0 +1,114 @@
+#pragma once
+#include <salt/memory/allocator_storage.hpp>
+
+#include <memory_resource>
+
+namespace salt {
+
+// A std::pmr::memory_resource that allocates with a RawAllocator, so that std::pmr containers can
+// use salt allocators. Allocations up to the maximum node size of the allocator are nodes, larger
+// ones are arrays of bytes.
+// NOTE:
+//  It stores an Allocator_reference, so a stateful allocator must outlive the resource.
+template <raw_allocator RawAllocator>
+class [[nodiscard]] Memory_resource_adaptor final : public std::pmr::memory_resource {
+    using allocator_reference = Allocator_reference<RawAllocator>;
+
+public:
+    using allocator_type = typename allocator_reference::allocator_type;
+
+    // clang-format off
+    template <typename Allocator> requires(
+        not std::derived_from<std::decay_t<Allocator>, Memory_resource_adaptor>)
+    explicit Memory_resource_adaptor(Allocator&& allocator) noexcept
+            : allocator_{std::forward<Allocator>(allocator)} {}
+    // clang-format on
+
+    allocator_type& allocator() const noexcept {
+        return allocator_.allocator();
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (bytes <= allocator_.max_node_size())
+            return allocator_.allocate_node(bytes, alignment);
+        return allocator_.allocate_array(bytes, 1u, alignment);
+    }
+
+    void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override {
+        if (bytes <= allocator_.max_node_size())
+            allocator_.deallocate_node(memory, bytes, alignment);
+        else
+            allocator_.deallocate_array(memory, bytes, 1u, alignment);
+    }
+
+    // Resources are equal if the memory of one can be deallocated by the other, i.e. they use the
+    // same allocator or a stateless one.
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+        if (this == &other)
+            return true;
+
+        auto const adaptor = dynamic_cast<Memory_resource_adaptor const*>(&other);
+        if (!adaptor)
+            return false;
+        if constexpr (not allocator_traits<allocator_type>::is_stateful::value)
+            return true;
+        else if constexpr (is_shared_allocator<allocator_type>::value)
+            return allocator() == adaptor->allocator();
+        else
+            return &allocator() == &adaptor->allocator();
+    }
+
+    allocator_reference allocator_;
+};
+
+template <raw_allocator RawAllocator>
+Memory_resource_adaptor(RawAllocator&&) -> Memory_resource_adaptor<std::decay_t<RawAllocator>>;
+
+// A RawAllocator that allocates from a std::pmr::memory_resource, the reverse of
+// Memory_resource_adaptor. It only stores a pointer to the resource, which must outlive it.
+class [[nodiscard]] Memory_resource_allocator final {
+public:
+    using allocator_type  = Memory_resource_allocator;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_stateful     = std::true_type;
+
+    explicit Memory_resource_allocator(
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+            : resource_{resource} {}
+
+    void* allocate_node(size_type size, size_type alignment) {
+        return resource_->allocate(size, alignment);
+    }
+
+    void* allocate_array(size_type count, size_type size, size_type alignment) {
+        return resource_->allocate(count * size, alignment);
+    }
+
+    void deallocate_node(void* node, size_type size, size_type alignment) noexcept {
+        resource_->deallocate(node, size, alignment);
+    }
+
+    void deallocate_array(void* array, size_type count, size_type size,
+                          size_type alignment) noexcept {
+        resource_->deallocate(array, count * size, alignment);
+    }
+
+    std::pmr::memory_resource* resource() const noexcept {
+        return resource_;
+    }
+
+    friend bool operator==(Memory_resource_allocator const& lhs,
+                           Memory_resource_allocator const& rhs) noexcept {
+        return lhs.resource_->is_equal(*rhs.resource_);
+    }
+
+private:
+    std::pmr::memory_resource* resource_;
+};
+
+// It only refers to the resource, so its copies share it.
+template <> struct [[nodiscard]] is_shared_allocator<Memory_resource_allocator> : std::true_type {};
+
+} // namespace salt
@@ -2,9 +2,13 @@
 
 #include <salt/memory/allocator_storage.hpp>
 #include <salt/memory/memory_stack.hpp>
+#include <salt/memory/virtual_memory.hpp>
 
 #include <salt/memory/detail/test_allocator.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 TEST_CASE("salt::Memory_stack", "[salt-memory/memory_stack.hpp]") {
     using namespace salt;
     using Memory_stack = Memory_stack<Allocator_reference<Test_allocator>>;
@@ -139,4 +143,94 @@ TEST_CASE("salt::Memory_stack", "[salt-memory/memory_stack.hpp]") {
         auto mem   = stack.allocate(align, align);
         REQUIRE(detail::is_aligned(mem, align));
     }
-}
\ No newline at end of file
+
+    SECTION("save/restore") {
+        auto value = static_cast<int*>(stack.allocate(sizeof(int), alignof(int)));
+        *value     = 1;
+
+        Memory_stack_snapshot snapshot;
+        REQUIRE(snapshot.empty());
+        stack.save(snapshot);
+        REQUIRE(!snapshot.empty());
+        auto const marker = stack.top();
+
+        *value = 2;
+        stack.allocate(100u, 1u);
+        REQUIRE(allocator.no_allocated() == 2u);
+
+        // The block of the snapshot is reused from the cache.
+        REQUIRE(stack.restore(snapshot));
+        REQUIRE(stack.top() == marker);
+        REQUIRE(*value == 1);
+
+        *value = 3;
+        REQUIRE(stack.restore(snapshot));
+        REQUIRE(*value == 1);
+    }
+}
+
+TEST_CASE("salt::Memory_stack with Virtual_block_allocator", "[salt-memory/memory_stack.hpp]") {
+    using namespace salt;
+    using Memory_stack = Memory_stack<Virtual_block_allocator>;
+
+    auto const   page_size = virtual_memory_page_size();
+    Memory_stack stack{page_size, 4u};
+
+    auto first = static_cast<int*>(stack.allocate(sizeof(int), alignof(int)));
+    *first     = 1;
+    auto start = stack.top();
+    stack.allocate(page_size / 2u, alignof(int));
+    auto last = static_cast<int*>(stack.allocate(page_size / 2u, alignof(int)));
+    *last     = 2;
+
+    Memory_stack_snapshot snapshot;
+    stack.save(snapshot);
+    auto const marker = stack.top();
+    REQUIRE(marker.index == 1u);
+
+    // The blocks are given back, but allocated again at the same addresses.
+    stack.unwind(start);
+    stack.shrink_to_fit();
+    *first = 3;
+
+    REQUIRE(stack.restore(snapshot));
+    REQUIRE(stack.top() == marker);
+    REQUIRE(*first == 1);
+    REQUIRE(*last == 2);
+}
+
+TEST_CASE("salt::Memory_stack::allocate_zeroed", "[salt-memory/memory_stack.hpp]") {
+    using namespace salt;
+
+    auto const is_zeroed = [](void* memory, std::size_t size) {
+        auto const bytes = static_cast<unsigned char*>(memory);
+        return std::all_of(bytes, bytes + size, [](auto byte) { return byte == 0u; });
+    };
+
+    auto const page_size = virtual_memory_page_size();
+    SECTION("zeroed blocks") {
+        Memory_stack<Virtual_block_allocator> stack{page_size, 4u};
+
+        auto const marker = stack.top();
+        std::memset(stack.allocate(256u, 1u), 0xFF, 256u);
+        stack.unwind(marker);
+
+        // The memory used before is cleared again, the rest is still zeroed.
+        auto const memory = stack.allocate_zeroed(512u, 1u);
+        REQUIRE(is_zeroed(memory, 512u));
+
+        using traits = allocator_traits<Memory_stack<Virtual_block_allocator>>;
+        auto const array = traits::allocate_zeroed_array(stack, 4u, page_size / 8u, 8u);
+        REQUIRE(is_zeroed(array, page_size / 2u));
+    }
+    SECTION("heap blocks") {
+        Memory_stack<> stack{4096u};
+
+        auto const marker = stack.top();
+        std::memset(stack.allocate(256u, 1u), 0xFF, 256u);
+        stack.unwind(marker);
+
+        auto const memory = stack.allocate_zeroed(256u, 1u);
+        REQUIRE(is_zeroed(memory, 256u));
+    }
+}
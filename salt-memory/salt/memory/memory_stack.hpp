@@ -2,8 +2,11 @@
 
 #define SALT_MEMORY_STACK_HAS_MIN_BLOCK_SIZE (1)
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
+#include <vector>
 
 #include <salt/memory/detail/fixed_memory_stack.hpp>
 #include <salt/memory/memory_arena.hpp>
@@ -47,6 +50,35 @@ struct [[nodiscard]] Memory_stack_leak_handler {
 
 } // namespace detail
 
+// The saved content of a Memory_stack, see Memory_stack::save(). It keeps its buffers, so saving
+// into the same snapshot again doesn't allocate once they are large enough.
+class [[nodiscard]] Memory_stack_snapshot {
+public:
+    Memory_stack_snapshot() noexcept = default;
+
+    bool empty() const noexcept {
+        return blocks_.empty();
+    }
+
+    // The number of saved bytes.
+    std::size_t size() const noexcept {
+        return data_.size();
+    }
+
+private:
+    struct [[nodiscard]] Block final {
+        std::byte*  memory;
+        std::size_t size;
+    };
+
+    std::vector<Block>     blocks_;
+    std::vector<std::byte> data_;
+    std::size_t            index_ = 0u;
+    std::byte*             top_   = nullptr;
+
+    template <typename> friend struct Memory_stack;
+};
+
 // A stateful RawAllocator that provides stack-like (LIFO) allocations. It uses a Memory_arena with
 // a given BlockOrRawAllocator defaulting to Growing_block_allocator to allocate huge blocks and
 // saves a marker to the current top. Allocation simply moves this marker by the appropriate number
@@ -62,8 +94,9 @@ struct Memory_stack : detail::Default_leak_detector<detail::Memory_stack_leak_ha
     // clang-format off
     template <typename... Args>
     constexpr explicit Memory_stack(size_type size, Args&&... args)
-            : arena_{size, std::forward<Args>(args)...},
-              stack_{arena_.allocate_block().memory   } {}
+            : arena_{size, std::forward<Args>(args)...} {
+        allocate_block();
+    }
     // clang-format on
 
     constexpr void* allocate(size_type size, size_type alignment) {
@@ -72,13 +105,21 @@ struct Memory_stack : detail::Default_leak_detector<detail::Memory_stack_leak_ha
 
         if (auto const grow_size = fence + offset + size + fence;
             !stack_.top() || grow_size > size_type(end() - stack_.top())) {
-            auto block = arena_.allocate_block();
-            stack_     = detail::Fixed_memory_stack(block.memory);
-            offset     = detail::align_offset(stack_.top() + fence, alignment);
+            allocate_block();
+            offset = detail::align_offset(stack_.top() + fence, alignment);
         }
         return stack_.allocate_unchecked(size, offset);
     }
 
+    // Allocates memory filled with zeros. Only the part that was used before is cleared, the memory
+    // of a new block of a zeroing_block_allocator is known to be zeroed.
+    constexpr void* allocate_zeroed(size_type size, size_type alignment) {
+        auto const memory = static_cast<std::byte*>(allocate(size, alignment));
+        if (memory < clean_)
+            std::memset(memory, 0, std::min(size, size_type(clean_ - memory)));
+        return memory;
+    }
+
     constexpr void* try_allocate(size_type size, size_type alignment) noexcept {
         return stack_.allocate(end(), size, alignment);
     }
@@ -111,20 +152,89 @@ struct Memory_stack : detail::Default_leak_detector<detail::Memory_stack_leak_ha
             detail::debug_fill_free(stack_marker.top,
                                     size_type(stack_marker.end - stack_marker.top), 0);
             stack_ = detail::Fixed_memory_stack(stack_marker.top);
+            clean_ = const_cast<std::byte*>(stack_marker.end);
         } else {
             detail::debug_check_pointer(
                     [&] {
                         return stack_.top() >= stack_marker.top;
                     },
                     info(), stack_marker.top);
+            clean_ = std::max(clean_, stack_.top());
             stack_.unwind(stack_marker.top);
         }
     }
 
+    // Copies the content of the stack up to its top into `snapshot`. Restoring the snapshot brings
+    // the whole stack back to this state with a copy per block, e.g. to roll back a simulation.
+    // NOTE:
+    //  * The content is restored bytewise, so the objects inside of the stack must be trivially
+    //    copyable or must not own anything outside of the stack.
+    //  * The pointers into the stack stay valid only if the blocks are allocated again at the same
+    //    addresses, which a Virtual_block_allocator guarantees.
+    void save(Memory_stack_snapshot& snapshot) const {
+        auto const current = top();
+        snapshot.index_    = current.index;
+        snapshot.top_      = current.top;
+        snapshot.blocks_.clear();
+
+        // The current block is used up to the top, the previous ones entirely.
+        size_type size = 0u;
+        arena_.for_each_block([&](Memory_block block) {
+            auto const memory = static_cast<std::byte*>(block.memory);
+            auto const used   = snapshot.blocks_.empty() ? size_type(current.top - memory)
+                                                     : block.size;
+            snapshot.blocks_.push_back({memory, used});
+            size += used;
+        });
+
+        snapshot.data_.resize(size);
+        auto data = snapshot.data_.data();
+        for (auto block : snapshot.blocks_) {
+            std::memcpy(data, block.memory, block.size);
+            data += block.size;
+        }
+    }
+
+    // Brings the stack back to the state of a snapshot taken with `save`. It returns false if the
+    // blocks of the snapshot are not at the same addresses anymore, e.g. because the cache of the
+    // arena was trimmed, the stack is then empty above the beginning of its current block.
+    bool restore(Memory_stack_snapshot const& snapshot) {
+        SALT_ASSERT(!snapshot.empty());
+        while (arena_.size() - 1u > snapshot.index_)
+            arena_.deallocate_block();
+        while (arena_.size() - 1u < snapshot.index_)
+            (void)arena_.allocate_block();
+
+        auto same  = true;
+        auto saved = snapshot.blocks_.begin();
+        arena_.for_each_block([&](Memory_block block) {
+            same = same && block.memory == (saved++)->memory;
+        });
+        clean_ = const_cast<std::byte*>(end());
+        if (!same) [[unlikely]] {
+            stack_ = detail::Fixed_memory_stack(arena_.current_block().memory);
+            return false;
+        }
+
+        auto data = snapshot.data_.data();
+        for (auto block : snapshot.blocks_) {
+            std::memcpy(block.memory, data, block.size);
+            data += block.size;
+        }
+        stack_ = detail::Fixed_memory_stack(snapshot.top_);
+        return true;
+    }
+
     constexpr void shrink_to_fit() noexcept {
         arena_.shrink_to_fit();
     }
 
+    // Gives back the cached blocks if the memory pressure registry requested a trim, see
+    // Memory_arena::serve_trim.
+    constexpr bool serve_trim() noexcept {
+        return arena_.serve_trim();
+    }
+
     constexpr size_type capacity_left() const noexcept {
         return size_type(end() - stack_.top());
     }
@@ -151,8 +261,18 @@ private:
         return static_cast<std::byte const*>(block.memory) + block.size;
     }
 
+    constexpr void allocate_block() {
+        bool       zeroed;
+        auto const block = arena_.allocate_block(zeroed);
+        stack_           = detail::Fixed_memory_stack(block.memory);
+        clean_           = static_cast<std::byte*>(block.memory) + (zeroed ? 0u : block.size);
+    }
+
     Memory_arena<allocator_type> arena_;
     detail::Fixed_memory_stack   stack_;
+    // The memory of the current block above both the top and this address was never used, so it is
+    // known to be zeroed if the block was.
+    std::byte* clean_ = nullptr;
 
     friend allocator_traits<Memory_stack>;
     friend composable_traits<Memory_stack>;
@@ -245,6 +365,25 @@ struct [[nodiscard]] allocator_traits<Memory_stack<BlockAllocator>> final {
         return allocate_node(allocator, count * size, alignment);
     }
 
+    static constexpr void*
+    allocate_zeroed_node(allocator_type& allocator,
+                         size_type       size     ,
+                         size_type       alignment)
+    {
+        auto* memory = allocator.allocate_zeroed(size, alignment);
+        allocator.on_allocate(size);
+        return memory;
+    }
+
+    static constexpr void*
+    allocate_zeroed_array(allocator_type& allocator,
+                          size_type       count    ,
+                          size_type       size     ,
+                          size_type       alignment)
+    {
+        return allocate_zeroed_node(allocator, count * size, alignment);
+    }
+
     static constexpr void
     deallocate_node(allocator_type& allocator,
                     void*           node     ,
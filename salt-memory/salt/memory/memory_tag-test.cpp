@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/containers.hpp>
+#include <salt/memory/heap_allocator.hpp>
+#include <salt/memory/memory_tag.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace salt;
+
+namespace {
+
+struct [[nodiscard]] Budget_calls final {
+    std::size_t count = 0u;
+    std::size_t size  = 0u;
+    bool        hard  = false;
+};
+
+Budget_calls budget_calls;
+
+void test_budget_handler(Memory_tag const&, std::size_t size, std::size_t, bool hard) noexcept {
+    ++budget_calls.count;
+    budget_calls.size = size;
+    budget_calls.hard = hard;
+}
+
+} // namespace
+
+TEST_CASE("salt::Memory_tag", "[salt-memory/memory_tag.hpp]") {
+    auto const old_handler = set_budget_handler(test_budget_handler);
+    budget_calls           = {};
+
+    Memory_tag tag("test");
+    REQUIRE(tag.name() == "test");
+    auto const tags = memory_tags();
+    REQUIRE(std::ranges::find(tags, &tag) != tags.end());
+
+    auto allocator = make_tagged_allocator(tag, Heap_allocator{});
+    REQUIRE(&allocator.tag() == &tag);
+
+    SECTION("counters") {
+        auto node  = allocator.allocate_node(100u, 8u);
+        auto array = allocator.allocate_array(10u, 20u, 8u);
+        flush_memory_tags();
+        REQUIRE(tag.live() == 300u);
+        REQUIRE(tag.peak() == 300u);
+
+        allocator.deallocate_node(node, 100u, 8u);
+        flush_memory_tags();
+        REQUIRE(tag.live() == 200u);
+        REQUIRE(tag.peak() == 300u);
+
+        allocator.deallocate_array(array, 10u, 20u, 8u);
+        flush_memory_tags();
+        REQUIRE(tag.live() == 0u);
+        REQUIRE(tag.peak() == 300u);
+    }
+    SECTION("counters are flushed in batches") {
+        auto node = allocator.allocate_node(memory_tag_flush_size, 8u);
+        REQUIRE(tag.live() == memory_tag_flush_size);
+        allocator.deallocate_node(node, memory_tag_flush_size, 8u);
+        REQUIRE(tag.live() == 0u);
+    }
+    SECTION("Std_allocator") {
+        {
+            memory::vector<int, decltype(allocator)> values(allocator);
+            values.resize(100u);
+            flush_memory_tags();
+            REQUIRE(tag.live() == 100u * sizeof(int));
+        }
+        flush_memory_tags();
+        REQUIRE(tag.live() == 0u);
+    }
+    SECTION("soft budget") {
+        tag.budget({256u, std::size_t(-1)});
+        auto node1 = allocator.allocate_node(200u, 8u);
+        flush_memory_tags();
+        REQUIRE(budget_calls.count == 0u);
+
+        auto node2 = allocator.allocate_node(200u, 8u);
+        flush_memory_tags();
+        REQUIRE(budget_calls.count == 1u);
+        REQUIRE(budget_calls.size == 400u);
+        REQUIRE(!budget_calls.hard);
+
+        // The handler is only called when the budget is crossed.
+        auto node3 = allocator.allocate_node(200u, 8u);
+        flush_memory_tags();
+        REQUIRE(budget_calls.count == 1u);
+
+        allocator.deallocate_node(node3, 200u, 8u);
+        allocator.deallocate_node(node2, 200u, 8u);
+        allocator.deallocate_node(node1, 200u, 8u);
+    }
+    SECTION("hard budget") {
+        tag.budget({std::size_t(-1), 256u});
+        auto node = allocator.allocate_node(200u, 8u);
+        REQUIRE_THROWS_AS(allocator.allocate_node(100u, 8u), std::bad_alloc);
+        REQUIRE(budget_calls.count == 1u);
+        REQUIRE(budget_calls.size == 300u);
+        REQUIRE(budget_calls.hard);
+
+        allocator.deallocate_node(node, 200u, 8u);
+        flush_memory_tags();
+        REQUIRE(tag.live() == 0u);
+    }
+    SECTION("ids are reused") {
+        auto const id = [] {
+            Memory_tag scoped("scoped");
+            return scoped.id();
+        }();
+        for (std::size_t i = 0u; i != 2u * max_memory_tags; ++i) {
+            Memory_tag scoped("scoped");
+            REQUIRE(scoped.id() == id);
+        }
+    }
+    SECTION("the pending amounts of a destroyed tag are dropped") {
+        std::atomic<int> step = 0;
+        auto             old  = std::make_unique<Memory_tag>("old");
+        auto const       id   = old->id();
+
+        std::thread thread{[&] {
+            old->on_allocate(100u);
+            step = 1;
+            step.notify_one();
+            step.wait(1);
+            flush_memory_tags();
+        }};
+        step.wait(0);
+        old.reset();
+
+        Memory_tag reused("reused");
+        REQUIRE(reused.id() == id);
+        step = 2;
+        step.notify_one();
+        thread.join();
+        REQUIRE(reused.live() == 0u);
+    }
+
+    set_budget_handler(old_handler);
+}
@@ -0,0 +1,179 @@
+#include <salt/memory/memory_tag.hpp>
+
+#include <salt/foundation/fast_terminate.hpp>
+#include <salt/foundation/logger.hpp>
+
+#include <thread>
+
+namespace salt {
+
+namespace {
+
+void default_budget_handler(Memory_tag const& tag, std::size_t size, std::size_t budget,
+                            bool hard) noexcept {
+    if (hard)
+        error("Memory tag ", tag.name(), " would exceed its hard budget of ", budget,
+              " bytes with ", size, " bytes");
+    else
+        warning("Memory tag ", tag.name(), " exceeds its soft budget of ", budget, " bytes with ",
+                size, " bytes");
+}
+
+std::atomic<budget_handler> internal_budget_handler(default_budget_handler);
+
+// A slot of the tag registry, the id of a tag is the index of its slot. A slot is reused after its
+// tag was destroyed, the generation tells the pending amounts of the old tag from the new one.
+// A thread that flushes into the tag of a slot is counted as a reader, the destructor of the tag
+// waits for the readers after it cleared the slot.
+struct [[nodiscard]] Memory_tag_slot final {
+    std::atomic<bool>          claimed{false};
+    std::atomic<Memory_tag*>   tag{nullptr};
+    std::atomic<std::uint32_t> readers{0u};
+};
+
+Memory_tag_slot            tag_slots[max_memory_tags];
+std::atomic<std::uint64_t> tag_generation(0u);
+
+// The counters of other threads may not be flushed yet, so a live amount can be negative.
+constexpr std::size_t to_size(std::ptrdiff_t amount) noexcept {
+    return amount > 0 ? std::size_t(amount) : 0u;
+}
+
+} // namespace
+
+budget_handler set_budget_handler(budget_handler handler) {
+    return internal_budget_handler.exchange(handler ? handler : default_budget_handler);
+}
+
+budget_handler get_budget_handler() {
+    return internal_budget_handler;
+}
+
+// The amounts a thread has allocated under each tag since the last flush, they are flushed when the
+// thread exits.
+struct [[nodiscard]] Memory_tag_cache final {
+    Memory_tag_cache() noexcept = default;
+
+    ~Memory_tag_cache() {
+        flush();
+    }
+
+    void flush() noexcept {
+        for (std::size_t id = 0u; id != max_memory_tags; ++id)
+            flush(id);
+    }
+
+    void flush(std::size_t id) noexcept {
+        auto& entry = entries[id];
+        if (entry.amount == 0)
+            return;
+
+        // The accesses are sequentially consistent, so either the destructor of the tag sees the
+        // reader, or the reader sees the cleared slot.
+        auto& slot = tag_slots[id];
+        slot.readers.fetch_add(1u);
+        auto const tag = slot.tag.load();
+        if (tag && tag->generation_ == entry.generation)
+            tag->flush(entry.amount);
+        slot.readers.fetch_sub(1u, std::memory_order_release);
+        entry.amount = 0;
+    }
+
+    // Returns the pending amount of the tag, the amount of an older tag with the same id is dropped.
+    std::ptrdiff_t& pending(Memory_tag const& tag) noexcept {
+        auto& entry = entries[tag.id_];
+        if (entry.generation != tag.generation_) [[unlikely]]
+            entry = {0, tag.generation_};
+        return entry.amount;
+    }
+
+    struct [[nodiscard]] Entry final {
+        std::ptrdiff_t amount     = 0;
+        std::uint64_t  generation = 0u;
+    };
+
+    Entry entries[max_memory_tags]{};
+};
+
+namespace {
+
+thread_local Memory_tag_cache tag_cache;
+
+} // namespace
+
+Memory_tag::Memory_tag(std::string_view name, Memory_budget budget)
+        : name_{name}, id_{0u}, generation_{tag_generation.fetch_add(1u) + 1u}, soft_{budget.soft},
+          hard_{budget.hard} {
+    for (; id_ != max_memory_tags; ++id_) {
+        auto claimed = false;
+        if (tag_slots[id_].claimed.compare_exchange_strong(claimed, true))
+            break;
+    }
+    if (id_ == max_memory_tags) [[unlikely]]
+        salt::fast_terminate();
+    tag_slots[id_].tag.store(this);
+}
+
+Memory_tag::~Memory_tag() {
+    tag_cache.flush(id_);
+
+    auto& slot = tag_slots[id_];
+    slot.tag.store(nullptr);
+    while (slot.readers.load() != 0u)
+        std::this_thread::yield();
+    slot.claimed.store(false, std::memory_order_release);
+}
+
+void Memory_tag::on_allocate(std::size_t size) {
+    auto&      pending = tag_cache.pending(*this);
+    auto const hard    = hard_.load(std::memory_order_relaxed);
+    if (hard != std::size_t(-1)) {
+        auto const total = to_size(live_.load(std::memory_order_relaxed) + pending) + size;
+        if (total > hard) {
+            get_budget_handler()(*this, total, hard, true);
+            throw std::bad_alloc();
+        }
+    }
+
+    pending += std::ptrdiff_t(size);
+    if (pending >= std::ptrdiff_t(memory_tag_flush_size))
+        tag_cache.flush(id_);
+}
+
+void Memory_tag::on_deallocate(std::size_t size) noexcept {
+    auto& pending = tag_cache.pending(*this);
+    pending -= std::ptrdiff_t(size);
+    if (pending <= -std::ptrdiff_t(memory_tag_flush_size))
+        tag_cache.flush(id_);
+}
+
+void Memory_tag::flush(std::ptrdiff_t amount) noexcept {
+    auto const old_live = to_size(live_.fetch_add(amount, std::memory_order_relaxed));
+    auto const new_live = to_size(std::ptrdiff_t(old_live) + amount);
+    if (amount <= 0)
+        return;
+
+    auto peak = peak_.load(std::memory_order_relaxed);
+    while (new_live > peak &&
+           !peak_.compare_exchange_weak(peak, new_live, std::memory_order_relaxed))
+        ;
+
+    // Only report when the soft budget is crossed, not on every flush above it.
+    auto const soft = soft_.load(std::memory_order_relaxed);
+    if (old_live <= soft && new_live > soft)
+        get_budget_handler()(*this, new_live, soft, false);
+}
+
+void flush_memory_tags() noexcept {
+    tag_cache.flush();
+}
+
+std::vector<Memory_tag const*> memory_tags() {
+    std::vector<Memory_tag const*> result;
+    for (auto const& slot : tag_slots)
+        if (auto tag = slot.tag.load(std::memory_order_acquire))
+            result.push_back(tag);
+    return result;
+}
+
+} // namespace salt
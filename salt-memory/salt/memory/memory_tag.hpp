@@ -0,0 +1,181 @@
+#pragma once
+#include <salt/memory/allocator_traits.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <vector>
+
+namespace salt {
+
+class [[nodiscard]] Memory_tag;
+
+// The soft and hard memory budget of a Memory_tag in bytes. Exceeding the soft budget only calls
+// the budget handler, exceeding the hard budget calls it and lets the allocation fail.
+struct [[nodiscard]] Memory_budget final {
+    std::size_t soft = std::size_t(-1);
+    std::size_t hard = std::size_t(-1);
+};
+
+// The type of the handler called when a Memory_tag exceeds one of its budgets.
+using budget_handler = void (*)(Memory_tag const& tag, std::size_t size, std::size_t budget,
+                                bool hard);
+
+budget_handler set_budget_handler(budget_handler handler);
+
+budget_handler get_budget_handler();
+
+// The maximum number of Memory_tag objects that can be alive at the same time, the id of a
+// destroyed tag is reused.
+static constexpr inline std::size_t max_memory_tags = 64u;
+
+// The number of bytes a thread allocates or deallocates under a tag, before they are added to the
+// counters of the tag. It keeps the counters from being contended.
+static constexpr inline std::size_t memory_tag_flush_size = 16u * 1024u;
+
+// A category of memory, e.g. a subsystem, with live and peak counters and a budget. The counters
+// are aggregated per-thread and flushed every `memory_tag_flush_size` bytes, so they lag behind by
+// at most that amount per thread. A tag lives as long as allocators reference it, it is usually a
+// global object. The destructor waits for the threads that are flushing into the tag, the amounts
+// other threads have not flushed yet are dropped.
+class [[nodiscard]] Memory_tag {
+public:
+    explicit Memory_tag(std::string_view name, Memory_budget budget = {});
+
+    ~Memory_tag();
+
+    Memory_tag(Memory_tag&&) = delete;
+    Memory_tag& operator=(Memory_tag&&) = delete;
+
+    void on_allocate(std::size_t size);
+
+    void on_deallocate(std::size_t size) noexcept;
+
+    std::string_view name() const noexcept {
+        return name_;
+    }
+
+    std::size_t id() const noexcept {
+        return id_;
+    }
+
+    std::size_t live() const noexcept {
+        auto const live = live_.load(std::memory_order_relaxed);
+        return live > 0 ? std::size_t(live) : 0u;
+    }
+
+    std::size_t peak() const noexcept {
+        return peak_.load(std::memory_order_relaxed);
+    }
+
+    Memory_budget budget() const noexcept {
+        return {soft_.load(std::memory_order_relaxed), hard_.load(std::memory_order_relaxed)};
+    }
+
+    void budget(Memory_budget budget) noexcept {
+        soft_.store(budget.soft, std::memory_order_relaxed);
+        hard_.store(budget.hard, std::memory_order_relaxed);
+    }
+
+private:
+    void flush(std::ptrdiff_t amount) noexcept;
+
+    std::string_view            name_;
+    std::size_t                 id_;
+    std::uint64_t               generation_;
+    std::atomic<std::ptrdiff_t> live_{0};
+    std::atomic<std::size_t>    peak_{0u};
+    std::atomic<std::size_t>    soft_;
+    std::atomic<std::size_t>    hard_;
+
+    friend struct Memory_tag_cache;
+};
+
+// Adds the pending amounts of the calling thread to the counters of all tags.
+void flush_memory_tags() noexcept;
+
+// Returns all the live tags.
+std::vector<Memory_tag const*> memory_tags();
+
+// A RawAllocator that accounts every allocation of the given RawAllocator to a Memory_tag. Use it
+// with an Allocator_reference to tag a shared allocator, or with Std_allocator to tag a container.
+template <typename RawAllocator>
+class [[nodiscard]] Tagged_allocator : allocator_traits<RawAllocator>::allocator_type {
+    using allocator_traits = allocator_traits<RawAllocator>;
+
+public:
+    using allocator_type  = typename allocator_traits::allocator_type;
+    using is_stateful     = std::true_type;
+    using size_type       = typename allocator_traits::size_type;
+    using difference_type = typename allocator_traits::difference_type;
+
+    constexpr explicit Tagged_allocator(Memory_tag&    tag,
+                                        allocator_type allocator = allocator_type{})
+            : allocator_type{std::move(allocator)}, tag_{&tag} {}
+
+    void* allocate_node(size_type size, size_type alignment) {
+        tag_->on_allocate(size);
+        try {
+            return allocator_traits::allocate_node(allocator(), size, alignment);
+        } catch (...) {
+            tag_->on_deallocate(size);
+            throw;
+        }
+    }
+
+    void* allocate_array(size_type count, size_type size, size_type alignment) {
+        tag_->on_allocate(count * size);
+        try {
+            return allocator_traits::allocate_array(allocator(), count, size, alignment);
+        } catch (...) {
+            tag_->on_deallocate(count * size);
+            throw;
+        }
+    }
+
+    void deallocate_node(void* node, size_type size, size_type alignment) noexcept {
+        allocator_traits::deallocate_node(allocator(), node, size, alignment);
+        tag_->on_deallocate(size);
+    }
+
+    void deallocate_array(void* array, size_type count, size_type size,
+                          size_type alignment) noexcept {
+        allocator_traits::deallocate_array(allocator(), array, count, size, alignment);
+        tag_->on_deallocate(count * size);
+    }
+
+    size_type max_node_size() const noexcept {
+        return allocator_traits::max_node_size(allocator());
+    }
+
+    size_type max_array_size() const noexcept {
+        return allocator_traits::max_array_size(allocator());
+    }
+
+    size_type max_alignment() const noexcept {
+        return allocator_traits::max_alignment(allocator());
+    }
+
+    constexpr allocator_type& allocator() noexcept {
+        return *this;
+    }
+
+    constexpr allocator_type const& allocator() const noexcept {
+        return *this;
+    }
+
+    constexpr Memory_tag& tag() const noexcept {
+        return *tag_;
+    }
+
+private:
+    Memory_tag* tag_;
+};
+
+template <raw_allocator RawAllocator>
+constexpr auto make_tagged_allocator(Memory_tag& tag, RawAllocator&& allocator) {
+    return Tagged_allocator<std::decay_t<RawAllocator>>{tag, std::forward<RawAllocator>(allocator)};
+}
+
+} // namespace salt
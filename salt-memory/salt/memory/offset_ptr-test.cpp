@@ -0,0 +1,70 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/offset_ptr.hpp>
+
+#include <cstring>
+
+using namespace salt;
+
+namespace {
+
+struct [[nodiscard]] Node final {
+    int              value;
+    Offset_ptr<Node> next;
+};
+
+} // namespace
+
+TEST_CASE("salt::Offset_ptr", "[salt-memory/offset_ptr.hpp]") {
+    int values[4] = {0, 1, 2, 3};
+
+    Offset_ptr<int> null;
+    REQUIRE(!null);
+    REQUIRE(null == nullptr);
+    REQUIRE(null.get() == nullptr);
+
+    Offset_ptr<int> ptr = values;
+    REQUIRE(ptr);
+    REQUIRE(ptr.get() == values);
+    REQUIRE(*ptr == 0);
+    REQUIRE(ptr[2] == 2);
+
+    SECTION("copy") {
+        auto copy = ptr;
+        REQUIRE(copy == ptr);
+        REQUIRE(copy.get() == values);
+
+        Offset_ptr<int const> const_copy = ptr;
+        REQUIRE(const_copy.get() == values);
+
+        Offset_ptr<void> void_copy = ptr;
+        REQUIRE(void_copy.get() == values);
+    }
+    SECTION("arithmetic") {
+        ++ptr;
+        REQUIRE(*ptr == 1);
+        ptr += 2;
+        REQUIRE(*ptr == 3);
+        REQUIRE(*(ptr - 1) == 2);
+        REQUIRE(ptr - Offset_ptr<int>(values) == 3);
+        REQUIRE(ptr > Offset_ptr<int>(values));
+        REQUIRE(*ptr-- == 3);
+        REQUIRE(*ptr == 2);
+    }
+    SECTION("relocation") {
+        // A pointer between objects of the same memory stays valid when the memory is copied.
+        Node nodes[2];
+        nodes[0] = {1, &nodes[1]};
+        nodes[1] = {2, nullptr};
+
+        alignas(Node) std::byte copy[sizeof(nodes)];
+        std::memcpy(copy, nodes, sizeof(nodes));
+        nodes[0] = nodes[1] = {};
+
+        auto const first = std::launder(reinterpret_cast<Node*>(copy));
+        REQUIRE(first->value == 1);
+        REQUIRE(first->next.get() == first + 1);
+        REQUIRE(first->next->value == 2);
+        REQUIRE(!first->next->next);
+    }
+}
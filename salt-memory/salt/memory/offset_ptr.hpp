@@ -0,0 +1,143 @@
+#pragma once
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace salt {
+
+// A pointer that stores the distance from itself to the object it points to. It stays valid when
+// the memory holding both of them is copied or mapped to another address as a whole, e.g. in a
+// Mapped_file_arena.
+// NOTE:
+//  * A null pointer is stored as distance 0, so an Offset_ptr cannot point to itself.
+//  * Copying an Offset_ptr recomputes the distance, so it is not trivially copyable.
+template <typename T> class [[nodiscard]] Offset_ptr {
+public:
+    using element_type      = T;
+    using difference_type   = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    Offset_ptr() noexcept = default;
+
+    Offset_ptr(std::nullptr_t) noexcept {}
+
+    Offset_ptr(T* ptr) noexcept {
+        assign(ptr);
+    }
+
+    Offset_ptr(Offset_ptr const& other) noexcept {
+        assign(other.get());
+    }
+
+    template <typename U>
+        requires std::convertible_to<U*, T*>
+    Offset_ptr(Offset_ptr<U> const& other) noexcept {
+        assign(other.get());
+    }
+
+    Offset_ptr& operator=(Offset_ptr const& other) noexcept {
+        assign(other.get());
+        return *this;
+    }
+
+    Offset_ptr& operator=(T* ptr) noexcept {
+        assign(ptr);
+        return *this;
+    }
+
+    T* get() const noexcept {
+        if (offset_ == 0)
+            return nullptr;
+        return reinterpret_cast<T*>(address() + std::uintptr_t(offset_));
+    }
+
+    template <typename U = T>
+        requires(not std::is_void_v<U>)
+    U& operator*() const noexcept {
+        return *get();
+    }
+
+    T* operator->() const noexcept {
+        return get();
+    }
+
+    template <typename U = T>
+        requires(not std::is_void_v<U>)
+    U& operator[](difference_type index) const noexcept {
+        return get()[index];
+    }
+
+    explicit operator bool() const noexcept {
+        return offset_ != 0;
+    }
+
+    Offset_ptr& operator+=(difference_type count) noexcept {
+        assign(get() + count);
+        return *this;
+    }
+
+    Offset_ptr& operator-=(difference_type count) noexcept {
+        assign(get() - count);
+        return *this;
+    }
+
+    Offset_ptr& operator++() noexcept {
+        return *this += 1;
+    }
+
+    Offset_ptr& operator--() noexcept {
+        return *this -= 1;
+    }
+
+    Offset_ptr operator++(int) noexcept {
+        auto result = *this;
+        ++*this;
+        return result;
+    }
+
+    Offset_ptr operator--(int) noexcept {
+        auto result = *this;
+        --*this;
+        return result;
+    }
+
+    friend Offset_ptr operator+(Offset_ptr const& ptr, difference_type count) noexcept {
+        return ptr.get() + count;
+    }
+
+    friend Offset_ptr operator-(Offset_ptr const& ptr, difference_type count) noexcept {
+        return ptr.get() - count;
+    }
+
+    friend difference_type operator-(Offset_ptr const& lhs, Offset_ptr const& rhs) noexcept {
+        return lhs.get() - rhs.get();
+    }
+
+    friend bool operator==(Offset_ptr const& lhs, Offset_ptr const& rhs) noexcept {
+        return lhs.get() == rhs.get();
+    }
+
+    friend bool operator==(Offset_ptr const& ptr, std::nullptr_t) noexcept {
+        return !ptr;
+    }
+
+    friend std::strong_ordering operator<=>(Offset_ptr const& lhs, Offset_ptr const& rhs) noexcept {
+        return std::compare_three_way{}(lhs.get(), rhs.get());
+    }
+
+private:
+    std::uintptr_t address() const noexcept {
+        return reinterpret_cast<std::uintptr_t>(this);
+    }
+
+    void assign(T* ptr) noexcept {
+        offset_ = ptr ? difference_type(reinterpret_cast<std::uintptr_t>(ptr) - address()) : 0;
+    }
+
+    difference_type offset_ = 0;
+};
+
+} // namespace salt
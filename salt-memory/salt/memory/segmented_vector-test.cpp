@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/segmented_vector.hpp>
+
+#include <salt/foundation/slot_map.hpp>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+
+using namespace salt;
+
+TEST_CASE("salt::Segmented_vector", "[salt-memory/segmented_vector.hpp]") {
+    using vector_type = Segmented_vector<std::size_t>;
+    static_assert(std::ranges::random_access_range<vector_type>);
+    static_assert(std::is_nothrow_swappable_v<vector_type>);
+
+    vector_type vector;
+    REQUIRE(vector.empty());
+    REQUIRE(vector.capacity() == 0u);
+
+    vector.push_back(0u);
+    REQUIRE(vector.capacity() == vector_type::page_size);
+
+    // The elements never move when the vector grows.
+    auto const first = &vector.front();
+    for (std::size_t i = 1u; i != 10000u; ++i)
+        vector.push_back(i);
+    REQUIRE(&vector.front() == first);
+    REQUIRE(vector.size() == 10000u);
+    REQUIRE(vector.back() == 9999u);
+    REQUIRE(vector.page_count() == (10000u + vector_type::page_size - 1u) / vector_type::page_size);
+    for (std::size_t i = 0u; i != vector.size(); ++i)
+        REQUIRE(vector[i] == i);
+    REQUIRE(std::ranges::is_sorted(vector));
+    REQUIRE(std::ranges::equal(vector | std::views::reverse | std::views::take(2),
+                               std::vector<std::size_t>{9999u, 9998u}));
+
+    auto const it = vector.begin() + 5000;
+    REQUIRE(*it == 5000u);
+    REQUIRE(it[10] == 5010u);
+    REQUIRE(it - vector.begin() == 5000);
+    REQUIRE(vector_type::const_iterator{it} < vector.end());
+
+    // Reserving and shrinking work on whole pages.
+    vector.resize(10u);
+    REQUIRE(vector.capacity() > vector_type::page_size);
+    vector.shrink_to_fit();
+    REQUIRE(vector.capacity() == vector_type::page_size);
+    REQUIRE(&vector.front() == first);
+    vector.reserve(vector_type::page_size + 1u);
+    REQUIRE(vector.page_count() == 2u);
+
+    auto copy = vector;
+    REQUIRE(std::ranges::equal(copy, vector));
+
+    auto moved = std::move(vector);
+    REQUIRE(vector.empty());
+    REQUIRE(vector.capacity() == 0u);
+    REQUIRE(&moved.front() == first);
+    REQUIRE(moved.size() == 10u);
+
+    moved.clear();
+    moved.shrink_to_fit();
+    REQUIRE(moved.capacity() == 0u);
+}
+
+TEST_CASE("salt::Segmented_vector in a Slot_map", "[salt-memory/segmented_vector.hpp]") {
+    static_assert(slottable<std::string, unsigned, Segmented_vector, std::vector>);
+
+    using map_type = Slot_map<std::string, unsigned, Segmented_vector, std::vector>;
+
+    map_type                        map;
+    std::vector<map_type::key_type> keys;
+    for (std::size_t i = 0u; i != 2000u; ++i)
+        keys.push_back(map.insert(std::to_string(i)));
+
+    auto const last  = &map[keys[1999u]];
+    auto const other = &map[keys[1000u]];
+    map.erase(keys[0u]);
+    REQUIRE(map.size() == 1999u);
+    REQUIRE(!map.contains(keys[0u]));
+    REQUIRE(map[keys[1999u]] == "1999");
+    REQUIRE(map[keys[1000u]] == "1000");
+
+    // The last value was moved into the slot of the erased one, the others stay in place.
+    REQUIRE(&map[keys[1999u]] != last);
+    REQUIRE(&map[keys[1000u]] == other);
+}
@@ -0,0 +1,333 @@
+#pragma once
+#include <salt/memory/default_allocator.hpp>
+#include <salt/memory/memory_pool.hpp>
+
+#include <salt/config.hpp>
+#include <salt/foundation/logger.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace salt {
+
+// The size of a page of a Segmented_vector, a larger element gets a page of its own.
+static constexpr inline std::size_t segmented_vector_page_bytes = 16u * 1024u;
+
+// A vector that stores its elements in fixed-size pages, which are allocated from a Memory_pool.
+// Growing allocates a new page instead of moving the elements, so the cost of a growth doesn't
+// depend on the size, and pointers and references to the elements stay valid until they are
+// erased. The elements are found through a table of the pages, so it keeps random access. It can
+// be the ValueContainer of a Slot_map with large values.
+// NOTE:
+//  * The number of elements per page is a power of two, so an index is split with a shift.
+//  * The page table is a std::vector, growing it moves only the page pointers.
+//  * Iterators are invalidated when a page is added, like the ones of a std::vector.
+template <typename T, typename RawAllocator = Default_allocator>
+class [[nodiscard]] Segmented_vector {
+    using pool_type = Memory_pool<Node_pool, RawAllocator>;
+
+    template <typename U> class [[nodiscard]] Iterator;
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = T const&;
+    using pointer         = T*;
+    using const_pointer   = T const*;
+    using iterator        = Iterator<T>;
+    using const_iterator  = Iterator<T const>;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Segmented_vector doesn't support over-aligned types");
+
+    // clang-format off
+    static constexpr size_type page_size  = std::bit_floor(std::max(segmented_vector_page_bytes /
+                                                                    sizeof(T), size_type{1}));
+    static constexpr size_type page_shift = std::countr_zero(page_size);
+    static constexpr size_type page_mask  = page_size - 1u;
+    static constexpr size_type page_bytes = page_size * sizeof(T);
+    // clang-format on
+
+    // The number of pages of the first block of the pool, the next blocks grow.
+    static constexpr size_type pages_per_block = 4u;
+
+    Segmented_vector() noexcept = default;
+
+    ~Segmented_vector() {
+        release();
+    }
+
+    Segmented_vector(Segmented_vector const& other) : Segmented_vector{} {
+        reserve(other.size_);
+        for (auto const& value : other)
+            emplace_back(value);
+    }
+
+    Segmented_vector(Segmented_vector&& other) noexcept
+            : pool_{std::move(other.pool_)}, pages_{std::move(other.pages_)},
+              size_{std::exchange(other.size_, 0u)} {
+        other.pool_.reset();
+        other.pages_.clear();
+    }
+
+    Segmented_vector& operator=(Segmented_vector const& other) {
+        if (this != &other) {
+            auto copy = other;
+            *this     = std::move(copy);
+        }
+        return *this;
+    }
+
+    Segmented_vector& operator=(Segmented_vector&& other) noexcept {
+        if (this != &other) {
+            release();
+            pool_  = std::move(other.pool_);
+            pages_ = std::move(other.pages_);
+            size_  = std::exchange(other.size_, 0u);
+            other.pool_.reset();
+            other.pages_.clear();
+        }
+        return *this;
+    }
+
+    // Allocates the pages for at least `capacity` elements.
+    void reserve(size_type capacity) {
+        while (this->capacity() < capacity)
+            add_page();
+    }
+
+    // Gives the pages that hold no elements back to the pool, the pool is destroyed with the last
+    // page.
+    void shrink_to_fit() noexcept {
+        auto const used = (size_ + page_mask) >> page_shift;
+        while (pages_.size() > used) {
+            pool_->deallocate_node(pages_.back());
+            pages_.pop_back();
+        }
+        if (pages_.empty())
+            pool_.reset();
+    }
+
+    template <typename... Args> T& emplace_back(Args&&... args) {
+        if (size_ == capacity()) [[unlikely]]
+            add_page();
+        auto& result = *std::ranges::construct_at(element(size_), std::forward<Args>(args)...);
+        ++size_;
+        return result;
+    }
+
+    void push_back(T const& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        SALT_ASSERT(size_ != 0u);
+        std::destroy_at(element(--size_));
+    }
+
+    void resize(size_type size) {
+        while (size_ > size)
+            pop_back();
+        reserve(size);
+        while (size_ < size)
+            emplace_back();
+    }
+
+    void clear() noexcept {
+        while (size_ != 0u)
+            pop_back();
+    }
+
+    T& operator[](size_type index) noexcept {
+        SALT_ASSERT(index < size_);
+        return *element(index);
+    }
+
+    T const& operator[](size_type index) const noexcept {
+        SALT_ASSERT(index < size_);
+        return *element(index);
+    }
+
+    T& front() noexcept {
+        return (*this)[0u];
+    }
+
+    T const& front() const noexcept {
+        return (*this)[0u];
+    }
+
+    T& back() noexcept {
+        return (*this)[size_ - 1u];
+    }
+
+    T const& back() const noexcept {
+        return (*this)[size_ - 1u];
+    }
+
+    iterator begin() noexcept {
+        return {pages_.data(), 0};
+    }
+
+    iterator end() noexcept {
+        return {pages_.data(), difference_type(size_)};
+    }
+
+    const_iterator begin() const noexcept {
+        return {pages_.data(), 0};
+    }
+
+    const_iterator end() const noexcept {
+        return {pages_.data(), difference_type(size_)};
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0u;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    // The number of elements that fit into the allocated pages.
+    size_type capacity() const noexcept {
+        return pages_.size() * page_size;
+    }
+
+    size_type page_count() const noexcept {
+        return pages_.size();
+    }
+
+private:
+    T* element(size_type index) const noexcept {
+        return pages_[index >> page_shift] + (index & page_mask);
+    }
+
+    // The page table grows geometrically before the page is allocated, so the push_back cannot
+    // throw and leak the page.
+    void add_page() {
+        if (pages_.size() == pages_.capacity())
+            pages_.reserve(std::max<size_type>(4u, 2u * pages_.capacity()));
+        if (!pool_)
+            pool_.emplace(page_bytes, pool_type::min_block_size(page_bytes, pages_per_block));
+        pages_.push_back(static_cast<T*>(pool_->allocate_node()));
+    }
+
+    void release() noexcept {
+        clear();
+        shrink_to_fit();
+    }
+
+    std::optional<pool_type> pool_;
+    std::vector<T*>          pages_;
+    size_type                size_ = 0u;
+};
+
+// A random access iterator over the pages, it holds the page table and the index of the element.
+template <typename T, typename RawAllocator>
+template <typename U>
+class [[nodiscard]] Segmented_vector<T, RawAllocator>::Iterator {
+public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type       = std::remove_const_t<U>;
+    using difference_type  = std::ptrdiff_t;
+    using pointer          = U*;
+    using reference        = U&;
+
+    Iterator() noexcept = default;
+
+    Iterator(T* const* pages, difference_type index) noexcept : pages_{pages}, index_{index} {}
+
+    // clang-format off
+    template <typename V> requires std::is_const_v<U> and (not std::is_const_v<V>)
+    Iterator(Iterator<V> const& other) noexcept : pages_{other.pages_}, index_{other.index_} {}
+    // clang-format on
+
+    U& operator*() const noexcept {
+        auto const index = size_type(index_);
+        return pages_[index >> page_shift][index & page_mask];
+    }
+
+    U* operator->() const noexcept {
+        return std::addressof(**this);
+    }
+
+    U& operator[](difference_type d) const noexcept {
+        return *(*this + d);
+    }
+
+    Iterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+        auto const temp = *this;
+        ++index_;
+        return temp;
+    }
+
+    Iterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    Iterator operator--(int) noexcept {
+        auto const temp = *this;
+        --index_;
+        return temp;
+    }
+
+    Iterator& operator+=(difference_type d) noexcept {
+        index_ += d;
+        return *this;
+    }
+
+    Iterator& operator-=(difference_type d) noexcept {
+        index_ -= d;
+        return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type d) noexcept {
+        return it += d;
+    }
+
+    friend Iterator operator+(difference_type d, Iterator it) noexcept {
+        return it += d;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type d) noexcept {
+        return it -= d;
+    }
+
+    friend difference_type operator-(Iterator const& lhs, Iterator const& rhs) noexcept {
+        return lhs.index_ - rhs.index_;
+    }
+
+    friend bool operator==(Iterator const& lhs, Iterator const& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend std::strong_ordering operator<=>(Iterator const& lhs, Iterator const& rhs) noexcept {
+        return lhs.index_ <=> rhs.index_;
+    }
+
+private:
+    T* const*       pages_ = nullptr;
+    difference_type index_ = 0;
+
+    template <typename> friend class Iterator;
+};
+
+} // namespace salt
@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/slot_map_snapshot.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+using namespace salt;
+
+namespace {
+
+struct Particle {
+    float         x, y;
+    std::uint32_t id;
+
+    bool operator==(Particle const&) const = default;
+};
+
+template <typename SlotMap> void require_same(SlotMap const& loaded, SlotMap const& map) {
+    REQUIRE(loaded.size() == map.size());
+    REQUIRE(loaded.free_index() == map.free_index());
+    REQUIRE(std::ranges::equal(loaded.keys(), map.keys()));
+    REQUIRE(std::ranges::equal(loaded.indices(), map.indices()));
+    REQUIRE(std::ranges::equal(loaded.values(), map.values()));
+}
+
+} // namespace
+
+TEST_CASE("salt::save_snapshot", "[salt-memory/slot_map_snapshot.hpp]") {
+    using Map = Slot_map<Particle, std::uint32_t, std::vector, std::vector, 8u>;
+
+    auto const path = std::filesystem::temp_directory_path() / "salt-slot_map_snapshot-test.bin";
+    std::filesystem::remove(path);
+
+    Map                        map;
+    std::vector<Map::key_type> keys;
+    for (std::uint32_t i = 0u; i != 1000u; ++i)
+        keys.push_back(map.insert({float(i), -float(i), i}));
+    for (std::size_t i = 0u; i < keys.size(); i += 3u)
+        map.erase(keys[i]);
+    auto const reused = map.insert({0.f, 0.f, 4242u});
+
+    save_snapshot(path, map);
+    REQUIRE(std::filesystem::file_size(path) % slot_map_snapshot_alignment ==
+            (map.size() * sizeof(Map::key_type)) % slot_map_snapshot_alignment);
+
+    SECTION("bulk read") {
+        auto loaded = load_snapshot<Map>(path);
+        require_same(loaded, map);
+        REQUIRE(loaded[reused].id == 4242u);
+        REQUIRE(!loaded.contains(keys[0]));
+        REQUIRE(loaded[keys[1]].id == 1u);
+
+        // The free list is restored, so new keys don't collide with the saved ones.
+        auto const key = loaded.insert({1.f, 1.f, 7u});
+        REQUIRE(key == map.insert({1.f, 1.f, 7u}));
+        REQUIRE(loaded[keys[1]].id == 1u);
+    }
+
+    SECTION("mapped view") {
+        Slot_map_view<Particle, std::uint32_t, 8u> const view{path};
+        REQUIRE(view.size() == map.size());
+        REQUIRE(std::ranges::equal(view.values(), map.values()));
+        REQUIRE(reinterpret_cast<std::uintptr_t>(view.values().data()) %
+                        slot_map_snapshot_alignment ==
+                0u);
+        REQUIRE(view[reused].id == 4242u);
+        REQUIRE(view.find(keys[0]) == nullptr);
+        for (std::size_t i = 1u; i < keys.size(); ++i)
+            REQUIRE(view.contains(keys[i]) == (i % 3u != 0u));
+
+        require_same(view.to_slot_map(), map);
+    }
+
+    SECTION("empty map") {
+        save_snapshot(path, Map{});
+        REQUIRE(load_snapshot<Map>(path).empty());
+        REQUIRE(Slot_map_view<Particle, std::uint32_t, 8u>{path}.empty());
+    }
+
+    SECTION("wrong type") {
+        REQUIRE_THROWS_AS(load_snapshot<Slot_map<Particle>>(path), std::system_error);
+        using Double_map = Slot_map<double, std::uint32_t, std::vector, std::vector, 8u>;
+        REQUIRE_THROWS_AS(load_snapshot<Double_map>(path), std::system_error);
+        REQUIRE_THROWS_AS((Slot_map_view<Particle, std::uint32_t>{path}), std::system_error);
+    }
+
+    SECTION("inconsistent arrays") {
+        auto header        = detail::make_snapshot_header<Map>();
+        header.value_count = map.size();
+        header.index_count = static_cast<std::uint64_t>(std::ranges::distance(map.indices()));
+
+        auto const patch = [&](std::uint64_t offset, auto value) {
+            save_snapshot(path, map);
+            std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+            file.seekp(std::streamoff(offset));
+            file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+        };
+        auto const require_invalid = [&] {
+            REQUIRE_THROWS_AS(load_snapshot<Map>(path), std::system_error);
+            Slot_map_view<Particle, std::uint32_t, 8u> const view{path};
+            REQUIRE_THROWS_AS(view.to_slot_map(), std::system_error);
+        };
+        auto const free_index = offsetof(detail::Slot_map_snapshot_header, free_index);
+
+        // A key whose index is out of bounds.
+        patch(header.keys_offset(), Map::key_type{Map::key_type::index_mask - 1u});
+        require_invalid();
+
+        // A key whose index refers to another key.
+        patch(header.keys_offset(), map.keys()[1]);
+        require_invalid();
+
+        // A free list that starts out of bounds or at the index of a key.
+        patch(free_index, header.index_count);
+        require_invalid();
+        patch(free_index, std::uint64_t{map.keys()[0].index()});
+        require_invalid();
+    }
+
+    SECTION("not a snapshot") {
+        std::ofstream{path, std::ios::trunc} << "not a snapshot";
+        REQUIRE_THROWS_AS(load_snapshot<Map>(path), std::system_error);
+        REQUIRE_THROWS_AS((Slot_map_view<Particle, std::uint32_t, 8u>{path}), std::system_error);
+
+        std::filesystem::remove(path);
+        REQUIRE_THROWS_AS(load_snapshot<Map>(path), std::system_error);
+    }
+
+    std::filesystem::remove(path);
+}
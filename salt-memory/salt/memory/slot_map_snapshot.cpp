@@ -0,0 +1,265 @@
+#include <salt/memory/slot_map_snapshot.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+#if SALT_TARGET(WINDOWS)
+#    define WIN32_LEAN_AND_MEAN
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
+namespace salt::detail {
+
+namespace {
+
+// "saltsmap" in little endian.
+constexpr std::uint64_t slot_map_snapshot_magic   = 0x70'61'6D'73'74'6C'61'73u;
+constexpr std::uint32_t slot_map_snapshot_version = 1u;
+
+[[noreturn]] void throw_system_error(int error, char const* what) {
+    throw std::system_error(error, std::system_category(), what);
+}
+
+[[noreturn]] void throw_not_a_snapshot() {
+    throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                            "salt::Slot_map snapshot: the file is not a snapshot of this type");
+}
+
+#if SALT_TARGET(WINDOWS)
+HANDLE to_handle(std::intptr_t handle) noexcept {
+    return reinterpret_cast<HANDLE>(handle);
+}
+
+std::uint64_t file_size(HANDLE file) noexcept {
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    return std::uint64_t(size.QuadPart);
+}
+#endif
+
+} // namespace
+
+Slot_map_snapshot_header make_snapshot_header(std::size_t value_size, std::size_t value_alignment,
+                                              std::size_t key_size, std::size_t generation_bits) {
+    return {
+            .magic           = slot_map_snapshot_magic,
+            .version         = slot_map_snapshot_version,
+            .value_size      = std::uint32_t(value_size),
+            .value_alignment = std::uint32_t(value_alignment),
+            .key_size        = std::uint32_t(key_size),
+            .generation_bits = generation_bits,
+            .value_count     = 0u,
+            .index_count     = 0u,
+            .free_index      = 0u,
+    };
+}
+
+void throw_invalid_snapshot() {
+    throw_not_a_snapshot();
+}
+
+void check_snapshot_size(std::uint64_t file_size) {
+    if (file_size < sizeof(Slot_map_snapshot_header))
+        throw_not_a_snapshot();
+}
+
+void check_snapshot_header(Slot_map_snapshot_header const& header,
+                           Slot_map_snapshot_header const& expected, std::uint64_t file_size) {
+    auto const max_count = file_size / std::max(header.key_size, std::uint32_t{1});
+    if (header.magic != expected.magic || header.version != expected.version ||
+        header.value_size != expected.value_size ||
+        header.value_alignment != expected.value_alignment ||
+        header.key_size != expected.key_size ||
+        header.generation_bits != expected.generation_bits ||
+        header.value_count > header.index_count || header.index_count > max_count ||
+        header.file_size() > file_size)
+        throw_not_a_snapshot();
+}
+
+#if SALT_TARGET(WINDOWS)
+// Windows has no vectored write for buffered files, the parts are written one after another.
+void write_snapshot_file(std::filesystem::path const&                 path,
+                         std::span<std::span<std::byte const> const> parts) {
+    auto const file = CreateFileW(path.c_str(), GENERIC_WRITE, 0u, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw_system_error(int(GetLastError()), "salt::Slot_map snapshot: can't create the file");
+
+    for (auto part : parts) {
+        while (!part.empty()) {
+            auto const size = DWORD(std::min<std::size_t>(part.size(), 1u << 30u));
+            DWORD      written;
+            if (!WriteFile(file, part.data(), size, &written, nullptr)) {
+                auto const error = GetLastError();
+                CloseHandle(file);
+                throw_system_error(int(error), "salt::Slot_map snapshot: can't write the file");
+            }
+            part = part.subspan(written);
+        }
+    }
+    CloseHandle(file);
+}
+
+Snapshot_file::Snapshot_file(std::filesystem::path const& path) {
+    auto const file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw_system_error(int(GetLastError()), "salt::Slot_map snapshot: can't open the file");
+    handle_ = reinterpret_cast<std::intptr_t>(file);
+    size_   = file_size(file);
+}
+
+Snapshot_file::~Snapshot_file() {
+    CloseHandle(to_handle(handle_));
+}
+
+void Snapshot_file::read(std::uint64_t offset, std::span<std::byte> bytes) const {
+    while (!bytes.empty()) {
+        OVERLAPPED position{};
+        position.Offset     = DWORD(offset & 0xFFFFFFFFu);
+        position.OffsetHigh = DWORD(offset >> 32u);
+
+        auto const size = DWORD(std::min<std::size_t>(bytes.size(), 1u << 30u));
+        DWORD      read;
+        if (!ReadFile(to_handle(handle_), bytes.data(), size, &read, &position))
+            throw_system_error(int(GetLastError()), "salt::Slot_map snapshot: can't read the file");
+        if (read == 0u)
+            throw_not_a_snapshot();
+        bytes = bytes.subspan(read);
+        offset += read;
+    }
+}
+
+Mapped_snapshot_file::Mapped_snapshot_file(std::filesystem::path const& path) {
+    auto const file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw_system_error(int(GetLastError()), "salt::Slot_map snapshot: can't open the file");
+
+    auto const size = file_size(file);
+    if (size == 0u) {
+        CloseHandle(file);
+        throw_not_a_snapshot();
+    }
+
+    auto const mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+    auto const error   = GetLastError();
+    CloseHandle(file);
+    if (!mapping)
+        throw_system_error(int(error), "salt::Slot_map snapshot: can't map the file");
+
+    auto const memory = MapViewOfFile(mapping, FILE_MAP_READ, 0u, 0u, 0u);
+    CloseHandle(mapping);
+    if (!memory)
+        throw_system_error(int(GetLastError()), "salt::Slot_map snapshot: can't map the file");
+    bytes_ = {static_cast<std::byte const*>(memory), std::size_t(size)};
+}
+
+Mapped_snapshot_file::~Mapped_snapshot_file() {
+    if (!bytes_.empty())
+        UnmapViewOfFile(bytes_.data());
+}
+#else
+void write_snapshot_file(std::filesystem::path const&                 path,
+                         std::span<std::span<std::byte const> const> parts) {
+    auto const file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file == -1)
+        throw_system_error(errno, "salt::Slot_map snapshot: can't create the file");
+
+    std::vector<iovec> buffers;
+    buffers.reserve(parts.size());
+    for (auto const part : parts)
+        if (!part.empty())
+            buffers.push_back({const_cast<std::byte*>(part.data()), part.size()});
+
+    // A vectored write may write only a part of the buffers, it is continued after the last byte.
+    auto remaining = std::span{buffers};
+    while (!remaining.empty()) {
+        auto const count   = int(std::min<std::size_t>(remaining.size(), IOV_MAX));
+        auto       written = ::writev(file, remaining.data(), count);
+        if (written == -1) {
+            if (errno == EINTR)
+                continue;
+            auto const error = errno;
+            ::close(file);
+            throw_system_error(error, "salt::Slot_map snapshot: can't write the file");
+        }
+        while (!remaining.empty() && std::size_t(written) >= remaining.front().iov_len) {
+            written -= ssize_t(remaining.front().iov_len);
+            remaining = remaining.subspan(1u);
+        }
+        if (written != 0) {
+            remaining.front().iov_base = static_cast<std::byte*>(remaining.front().iov_base) +
+                                         written;
+            remaining.front().iov_len -= std::size_t(written);
+        }
+    }
+
+    if (::close(file) != 0)
+        throw_system_error(errno, "salt::Slot_map snapshot: can't write the file");
+}
+
+Snapshot_file::Snapshot_file(std::filesystem::path const& path) {
+    auto const file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file == -1)
+        throw_system_error(errno, "salt::Slot_map snapshot: can't open the file");
+
+    struct stat status;
+    if (::fstat(file, &status) != 0) {
+        auto const error = errno;
+        ::close(file);
+        throw_system_error(error, "salt::Slot_map snapshot: can't open the file");
+    }
+    handle_ = file;
+    size_   = std::uint64_t(status.st_size);
+}
+
+Snapshot_file::~Snapshot_file() {
+    ::close(int(handle_));
+}
+
+void Snapshot_file::read(std::uint64_t offset, std::span<std::byte> bytes) const {
+    while (!bytes.empty()) {
+        auto const read = ::pread(int(handle_), bytes.data(), bytes.size(), off_t(offset));
+        if (read == -1) {
+            if (errno == EINTR)
+                continue;
+            throw_system_error(errno, "salt::Slot_map snapshot: can't read the file");
+        }
+        if (read == 0)
+            throw_not_a_snapshot();
+        bytes = bytes.subspan(std::size_t(read));
+        offset += std::uint64_t(read);
+    }
+}
+
+Mapped_snapshot_file::Mapped_snapshot_file(std::filesystem::path const& path) {
+    Snapshot_file const file{path};
+    if (file.size() == 0u)
+        throw_not_a_snapshot();
+
+    auto const size   = std::size_t(file.size());
+    auto const memory = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, int(file.handle()), 0);
+    if (memory == MAP_FAILED)
+        throw_system_error(errno, "salt::Slot_map snapshot: can't map the file");
+    bytes_ = {static_cast<std::byte const*>(memory), size};
+}
+
+Mapped_snapshot_file::~Mapped_snapshot_file() {
+    if (!bytes_.empty())
+        ::munmap(const_cast<std::byte*>(bytes_.data()), bytes_.size());
+}
+#endif
+
+} // namespace salt::detail
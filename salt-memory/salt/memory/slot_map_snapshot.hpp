@@ -0,0 +1,366 @@
+#pragma once
+#include <salt/config.hpp>
+#include <salt/foundation/logger.hpp>
+#include <salt/foundation/slot_map.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace salt {
+
+// The arrays of a snapshot start at multiples of this, so a mapped snapshot can be used in place.
+static constexpr inline std::size_t slot_map_snapshot_alignment = 64u;
+
+namespace detail {
+
+// The beginning of a Slot_map snapshot, the values, indices and keys follow in this order, each
+// at the next multiple of `slot_map_snapshot_alignment`.
+struct [[nodiscard]] Slot_map_snapshot_header final {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t value_size;
+    std::uint32_t value_alignment;
+    std::uint32_t key_size;
+    std::uint64_t generation_bits;
+    std::uint64_t value_count;
+    std::uint64_t index_count;
+    std::uint64_t free_index;
+
+    std::uint64_t values_offset() const noexcept {
+        return align(sizeof(Slot_map_snapshot_header));
+    }
+
+    std::uint64_t indices_offset() const noexcept {
+        return align(values_offset() + value_count * value_size);
+    }
+
+    std::uint64_t keys_offset() const noexcept {
+        return align(indices_offset() + index_count * key_size);
+    }
+
+    std::uint64_t file_size() const noexcept {
+        return keys_offset() + value_count * key_size;
+    }
+
+private:
+    static std::uint64_t align(std::uint64_t offset) noexcept {
+        return (offset + slot_map_snapshot_alignment - 1u) / slot_map_snapshot_alignment *
+               slot_map_snapshot_alignment;
+    }
+};
+
+// Returns the header of a snapshot of the type without the counts.
+Slot_map_snapshot_header make_snapshot_header(std::size_t value_size, std::size_t value_alignment,
+                                              std::size_t key_size, std::size_t generation_bits);
+
+// Throws std::system_error if a file of `file_size` bytes is too small for a snapshot header.
+void check_snapshot_size(std::uint64_t file_size);
+
+// Throws std::system_error if `header` is not the header of a snapshot of the same type as
+// `expected` or the file is too small for its arrays.
+void check_snapshot_header(Slot_map_snapshot_header const& header,
+                           Slot_map_snapshot_header const& expected, std::uint64_t file_size);
+
+// Throws the std::system_error of a file that is not a valid snapshot.
+[[noreturn]] void throw_invalid_snapshot();
+
+// Writes the parts into a new file at `path` with a single vectored write, it replaces an
+// existing file.
+void write_snapshot_file(std::filesystem::path const&                 path,
+                         std::span<std::span<std::byte const> const> parts);
+
+// A file opened for reading at arbitrary offsets.
+class [[nodiscard]] Snapshot_file final {
+public:
+    explicit Snapshot_file(std::filesystem::path const& path);
+
+    ~Snapshot_file();
+
+    Snapshot_file(Snapshot_file const&)            = delete;
+    Snapshot_file& operator=(Snapshot_file const&) = delete;
+
+    std::uint64_t size() const noexcept {
+        return size_;
+    }
+
+    // The file descriptor or HANDLE of the file.
+    std::intptr_t handle() const noexcept {
+        return handle_;
+    }
+
+    // Fills `bytes` from the file at `offset`, it throws std::system_error if the file ends
+    // before.
+    void read(std::uint64_t offset, std::span<std::byte> bytes) const;
+
+private:
+    std::intptr_t handle_;
+    std::uint64_t size_ = 0u;
+};
+
+// A whole file mapped as read-only memory.
+class [[nodiscard]] Mapped_snapshot_file final {
+public:
+    explicit Mapped_snapshot_file(std::filesystem::path const& path);
+
+    ~Mapped_snapshot_file();
+
+    Mapped_snapshot_file(Mapped_snapshot_file&& other) noexcept
+            : bytes_{std::exchange(other.bytes_, {})} {}
+
+    Mapped_snapshot_file& operator=(Mapped_snapshot_file&& other) noexcept {
+        std::swap(bytes_, other.bytes_);
+        return *this;
+    }
+
+    std::span<std::byte const> bytes() const noexcept {
+        return bytes_;
+    }
+
+private:
+    std::span<std::byte const> bytes_;
+};
+
+template <typename SlotMap>
+Slot_map_snapshot_header make_snapshot_header() {
+    using key_type = typename SlotMap::key_type;
+    return make_snapshot_header(sizeof(typename SlotMap::value_type),
+                                alignof(typename SlotMap::value_type), sizeof(key_type),
+                                key_type::generation_bits);
+}
+
+// Throws std::system_error unless the keys and indices are those of a Slot_map: every key refers
+// to an index that refers back to the key, and the free list only links the other indices. A
+// corrupt file would otherwise let the restored map access its arrays out of bounds.
+template <typename SlotMap>
+void check_snapshot_arrays(std::span<typename SlotMap::key_type const>   keys,
+                           std::span<typename SlotMap::index_type const> indices,
+                           std::uint64_t                                 free_index) {
+    using key_type = typename SlotMap::key_type;
+
+    auto              valid = indices.size() <= SlotMap::max_size();
+    std::vector<bool> used(valid ? indices.size() : 0u);
+    for (std::size_t i = 0u; valid && i != keys.size(); ++i) {
+        auto const idx = keys[i].index();
+        valid          = idx < indices.size() && !used[idx];
+        if (valid) {
+            used[idx]        = true;
+            auto const entry = key_type{indices[idx]};
+            valid = entry.index() == i && entry.generation() == keys[i].generation();
+        }
+    }
+    for (auto idx = free_index; valid && idx != key_type::index_mask;) {
+        valid = idx < indices.size() && !used[idx];
+        if (valid) {
+            used[idx] = true;
+            idx       = key_type{indices[idx]}.index();
+        }
+    }
+    if (!valid)
+        throw_invalid_snapshot();
+}
+
+template <typename Container> std::span<std::byte const> snapshot_bytes(Container const& c) {
+    auto const first = std::ranges::begin(c);
+    auto const size  = static_cast<std::size_t>(std::ranges::distance(c));
+    if (size == 0u)
+        return {};
+    return std::as_bytes(std::span{std::to_address(first), size});
+}
+
+} // namespace detail
+
+// A Slot_map that can be saved as a snapshot, the file holds the memory of its arrays, so its
+// values must be trivially copyable and its containers contiguous and resizable.
+// clang-format off
+template <typename SlotMap>
+concept snapshottable_slot_map =
+    std::is_trivially_copyable_v<typename SlotMap::value_type>            and
+    std::default_initializable<typename SlotMap::value_type>              and
+    alignof(typename SlotMap::value_type) <= slot_map_snapshot_alignment  and
+    std::ranges::contiguous_range<typename SlotMap::value_container>      and
+    std::ranges::contiguous_range<typename SlotMap::key_container>        and
+    std::ranges::contiguous_range<typename SlotMap::index_container>      and
+    requires(typename SlotMap::value_container values, typename SlotMap::key_container keys,
+             typename SlotMap::index_container indices, std::size_t size) {
+        values.resize(size);
+        keys.resize(size);
+        indices.resize(size);
+    };
+// clang-format on
+
+// Saves the map into a file at `path` with one vectored write of its arrays, it throws
+// std::system_error if the file can't be written. The keys of the map are valid for the map
+// loaded from the file.
+// NOTE:
+//  * The file format is the memory layout of the arrays, it is only portable between builds with
+//    the same ABI.
+template <snapshottable_slot_map SlotMap>
+void save_snapshot(std::filesystem::path const& path, SlotMap const& map) {
+    auto header        = detail::make_snapshot_header<SlotMap>();
+    header.value_count = map.size();
+    header.index_count = static_cast<std::uint64_t>(std::ranges::distance(map.indices()));
+    header.free_index  = map.free_index();
+
+    static constexpr std::array<std::byte, slot_map_snapshot_alignment> padding{};
+    auto const pad = [](std::uint64_t from, std::uint64_t to) {
+        return std::span{padding}.first(static_cast<std::size_t>(to - from));
+    };
+
+    auto const values  = detail::snapshot_bytes(map.values());
+    auto const indices = detail::snapshot_bytes(map.indices());
+    auto const keys    = detail::snapshot_bytes(map.keys());
+
+    std::span<std::byte const> const parts[] = {
+            std::as_bytes(std::span{&header, 1u}),
+            pad(sizeof(header), header.values_offset()),
+            values,
+            pad(header.values_offset() + values.size(), header.indices_offset()),
+            indices,
+            pad(header.indices_offset() + indices.size(), header.keys_offset()),
+            keys,
+    };
+    detail::write_snapshot_file(path, parts);
+}
+
+// Loads a map saved by `save_snapshot` with a bulk read of each array, it throws std::system_error
+// if the file can't be read, is not a snapshot of a map of the same type or its arrays are not
+// consistent.
+template <snapshottable_slot_map SlotMap> SlotMap load_snapshot(std::filesystem::path const& path) {
+    detail::Snapshot_file const      file{path};
+    detail::Slot_map_snapshot_header header;
+    detail::check_snapshot_size(file.size());
+    file.read(0u, std::as_writable_bytes(std::span{&header, 1u}));
+    detail::check_snapshot_header(header, detail::make_snapshot_header<SlotMap>(), file.size());
+
+    typename SlotMap::value_container values;
+    typename SlotMap::index_container indices;
+    typename SlotMap::key_container   keys;
+    values.resize(static_cast<std::size_t>(header.value_count));
+    indices.resize(static_cast<std::size_t>(header.index_count));
+    keys.resize(static_cast<std::size_t>(header.value_count));
+
+    file.read(header.values_offset(), std::as_writable_bytes(std::span{values}));
+    file.read(header.indices_offset(), std::as_writable_bytes(std::span{indices}));
+    file.read(header.keys_offset(), std::as_writable_bytes(std::span{keys}));
+    detail::check_snapshot_arrays<SlotMap>(keys, indices, header.free_index);
+
+    SlotMap map;
+    map.restore(std::move(values), std::move(keys), std::move(indices),
+                static_cast<typename SlotMap::index_type>(header.free_index));
+    return map;
+}
+
+// A read-only view of a snapshot of a Slot_map<T, KeyType, std::vector, std::vector,
+// GenerationBits>, the file is mapped and its arrays are used in place, so opening it costs no
+// copy and the pages are only read when they are accessed. The keys of the saved map are valid.
+// NOTE:
+//  * The view must outlive the references to its values.
+template <typename T, std::unsigned_integral KeyType = unsigned, std::size_t GenerationBits = 0u>
+class [[nodiscard]] Slot_map_view {
+public:
+    using slot_map   = Slot_map<T, KeyType, std::vector, std::vector, GenerationBits>;
+    using key_type   = typename slot_map::key_type;
+    using index_type = typename slot_map::index_type;
+    using size_type  = std::size_t;
+    using value_type = T;
+
+    static_assert(snapshottable_slot_map<slot_map>);
+
+    // Maps the snapshot at `path`, it throws std::system_error if the file can't be mapped or is
+    // not a snapshot of a map of this type.
+    explicit Slot_map_view(std::filesystem::path const& path) : file_{path} {
+        detail::check_snapshot_size(file_.bytes().size());
+        auto const& header = *array<detail::Slot_map_snapshot_header>(0u);
+        detail::check_snapshot_header(header, detail::make_snapshot_header<slot_map>(),
+                                      file_.bytes().size());
+
+        auto const value_count = static_cast<std::size_t>(header.value_count);
+        auto const index_count = static_cast<std::size_t>(header.index_count);
+        values_     = {array<T>(header.values_offset()), value_count};
+        indices_    = {array<index_type>(header.indices_offset()), index_count};
+        keys_       = {array<key_type>(header.keys_offset()), value_count};
+        free_index_ = static_cast<index_type>(header.free_index);
+    }
+
+    size_type size() const noexcept {
+        return values_.size();
+    }
+
+    bool empty() const noexcept {
+        return values_.empty();
+    }
+
+    // Returns the value of the key or null if it is not in the map, like Slot_map::find.
+    T const* find(key_type key) const noexcept {
+        if (key.index() >= indices_.size())
+            return nullptr;
+        auto const entry = key_type{indices_[key.index()]};
+        if (entry.generation() != key.generation())
+            return nullptr;
+        auto const value_idx = entry.index();
+        if (value_idx >= values_.size())
+            return nullptr;
+        if (key_type::generation_bits == 0u and keys_[value_idx] != key)
+            return nullptr;
+        return &values_[value_idx];
+    }
+
+    bool contains(key_type key) const noexcept {
+        return find(key) != nullptr;
+    }
+
+    T const& operator[](key_type key) const noexcept {
+        auto const value = find(key);
+        SALT_ASSERT(value != nullptr);
+        return *value;
+    }
+
+    // The arrays of the saved map, the n-th value belongs to the n-th key.
+    std::span<T const> values() const noexcept {
+        return values_;
+    }
+
+    std::span<key_type const> keys() const noexcept {
+        return keys_;
+    }
+
+    std::span<index_type const> indices() const noexcept {
+        return indices_;
+    }
+
+    index_type free_index() const noexcept {
+        return free_index_;
+    }
+
+    // Copies the view into a map that can be modified, it throws std::system_error if the arrays of
+    // the snapshot are not consistent.
+    slot_map to_slot_map() const {
+        detail::check_snapshot_arrays<slot_map>(keys_, indices_, free_index_);
+        slot_map map;
+        map.restore(typename slot_map::value_container(values_.begin(), values_.end()),
+                    typename slot_map::key_container(keys_.begin(), keys_.end()),
+                    typename slot_map::index_container(indices_.begin(), indices_.end()),
+                    free_index_);
+        return map;
+    }
+
+private:
+    template <typename U> U const* array(std::uint64_t offset) const noexcept {
+        return std::launder(reinterpret_cast<U const*>(file_.bytes().data() + offset));
+    }
+
+    detail::Mapped_snapshot_file file_;
+    std::span<T const>           values_;
+    std::span<index_type const>  indices_;
+    std::span<key_type const>    keys_;
+    index_type                   free_index_ = 0u;
+};
+
+} // namespace salt
@@ -61,3 +61,38 @@ TEST_CASE("salt::allocate_unique", "[salt-memory/smart_ptr.hpp]") {
         REQUIRE(Dummy_allocator::size == sizeof(int));
     }
 }
+
+namespace {
+
+struct [[nodiscard]] Joint_mesh final {
+    Joint_mesh(salt::Joint_stack& stack, std::size_t no_vertices, std::vector<int> const& values)
+            : vertices{no_vertices, stack, 1.5f}, indices{values, stack} {}
+
+    salt::Joint_array<float> vertices;
+    salt::Joint_array<int>   indices;
+};
+
+} // namespace
+
+TEST_CASE("salt::allocate_joint", "[salt-memory/smart_ptr.hpp]") {
+    using namespace salt;
+
+    Dummy_allocator::size = 0;
+    auto const indices    = std::vector<int>{1, 2, 3};
+    auto const size = Joint_size::array<float>(10u) + Joint_size::array<int>(indices.size());
+    auto       ptr  = allocate_joint<Joint_mesh>(Dummy_allocator{}, size, 10u, indices);
+
+    // The object and its arrays are a single allocation.
+    REQUIRE(Dummy_allocator::size == sizeof(Joint_mesh) + size.size);
+    REQUIRE(ptr.get_deleter().joint_size() == Dummy_allocator::size);
+
+    REQUIRE(ptr->vertices.size() == 10u);
+    REQUIRE(ptr->vertices[9] == 1.5f);
+    REQUIRE(std::ranges::equal(ptr->indices, indices));
+
+    auto const begin = reinterpret_cast<std::byte*>(ptr.get());
+    auto const end   = begin + Dummy_allocator::size;
+    REQUIRE(reinterpret_cast<std::byte*>(ptr->vertices.data()) >= begin + sizeof(Joint_mesh));
+    REQUIRE(reinterpret_cast<std::byte*>(ptr->indices.end()) <= end);
+    REQUIRE(detail::is_aligned(ptr->indices.data(), alignof(int)));
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
 #include <salt/memory/deleter.hpp>
 #include <salt/memory/std_allocator.hpp>
@@ -45,6 +46,177 @@ auto allocate_array_unique(std::size_t size, Allocator_reference<RawAllocator> a
 
 } // namespace detail
 
+// The size of the trailing memory of a joint allocation. The size of an array includes its worst
+// case alignment padding, the sizes of several arrays are added together.
+struct [[nodiscard]] Joint_size final {
+    std::size_t size = 0u;
+
+    template <typename T> static constexpr Joint_size array(std::size_t count) noexcept {
+        return {count * sizeof(T) + alignof(T) - 1u};
+    }
+
+    friend constexpr Joint_size operator+(Joint_size lhs, Joint_size rhs) noexcept {
+        return {lhs.size + rhs.size};
+    }
+};
+
+// The trailing memory of a joint allocation, it is passed as first argument to the constructor of
+// the object and hands out the memory to its Joint_array members.
+class [[nodiscard]] Joint_stack final {
+public:
+    constexpr Joint_stack(void* memory, std::size_t size) noexcept
+            : top_{static_cast<std::byte*>(memory)}, end_{top_ + size} {}
+
+    Joint_stack(Joint_stack const&)            = delete;
+    Joint_stack& operator=(Joint_stack const&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment) noexcept {
+        auto const offset = detail::align_offset(top_, alignment);
+        SALT_ASSERT(offset + size <= std::size_t(end_ - top_));
+        auto const memory = top_ + offset;
+        top_              = memory + size;
+        return memory;
+    }
+
+    constexpr std::size_t capacity_left() const noexcept {
+        return std::size_t(end_ - top_);
+    }
+
+private:
+    std::byte* top_;
+    std::byte* end_;
+};
+
+// An array in the trailing memory of a joint allocation, it is a member of the joint object and
+// lives as long as it. It constructs and destroys its elements, the memory belongs to the object.
+template <typename T> class [[nodiscard]] Joint_array final {
+public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using iterator       = T*;
+    using const_iterator = T const*;
+
+    // Value-initializes `size` elements.
+    Joint_array(size_type size, Joint_stack& stack) : data_{allocate(size, stack)} {
+        construct([&] {
+            for (; size_ != size; ++size_)
+                std::ranges::construct_at(data_ + size_);
+        });
+    }
+
+    Joint_array(size_type size, Joint_stack& stack, T const& value)
+            : data_{allocate(size, stack)} {
+        construct([&] {
+            for (; size_ != size; ++size_)
+                std::ranges::construct_at(data_ + size_, value);
+        });
+    }
+
+    template <std::ranges::sized_range Range>
+    Joint_array(Range&& range, Joint_stack& stack)
+            : data_{allocate(std::ranges::size(range), stack)} {
+        construct([&] {
+            for (auto&& value : range)
+                std::ranges::construct_at(data_ + size_++, std::forward<decltype(value)>(value));
+        });
+    }
+
+    ~Joint_array() {
+        std::ranges::destroy(data_, data_ + size_);
+    }
+
+    Joint_array(Joint_array const&)            = delete;
+    Joint_array& operator=(Joint_array const&) = delete;
+
+    T& operator[](size_type index) noexcept {
+        SALT_ASSERT(index < size_);
+        return data_[index];
+    }
+
+    T const& operator[](size_type index) const noexcept {
+        SALT_ASSERT(index < size_);
+        return data_[index];
+    }
+
+    T* data() noexcept {
+        return data_;
+    }
+
+    T const* data() const noexcept {
+        return data_;
+    }
+
+    iterator begin() noexcept {
+        return data_;
+    }
+
+    iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept {
+        return data_;
+    }
+
+    const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0u;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    operator std::span<T>() noexcept {
+        return {data_, size_};
+    }
+
+    operator std::span<T const>() const noexcept {
+        return {data_, size_};
+    }
+
+private:
+    static T* allocate(size_type size, Joint_stack& stack) noexcept {
+        return static_cast<T*>(stack.allocate(size * sizeof(T), alignof(T)));
+    }
+
+    // The destructor doesn't run if a constructor throws, so the elements are destroyed here.
+    template <typename Function> void construct(Function function) {
+        try {
+            function();
+        } catch (...) {
+            std::ranges::destroy(data_, data_ + size_);
+            throw;
+        }
+    }
+
+    T*        data_;
+    size_type size_ = 0u;
+};
+
+namespace detail {
+
+template <typename T, raw_allocator RawAllocator, typename... Args>
+auto allocate_joint(Allocator_reference<RawAllocator> allocator, Joint_size joint_size,
+                    Args&&... args) -> std::unique_ptr<T, Joint_deleter<T, RawAllocator>> {
+    auto const size   = sizeof(T) + joint_size.size;
+    auto*      memory = allocator.allocate_node(size, alignof(T));
+    // the memory is deallocated as a node of `size` bytes in case of constructor exception
+    auto deallocate = [&](void* node) {
+        allocator.deallocate_node(node, size, alignof(T));
+    };
+    std::unique_ptr<void, decltype(deallocate)> result{memory, deallocate};
+
+    Joint_stack stack{static_cast<std::byte*>(memory) + sizeof(T), joint_size.size};
+    std::ranges::construct_at(static_cast<T*>(memory), stack, std::forward<Args>(args)...);
+    return {static_cast<T*>(result.release()), {allocator, size}};
+}
+
+} // namespace detail
+
 template <typename T, raw_allocator RawAllocator>
 using unique_ptr = std::unique_ptr<T, Deleter<T, RawAllocator>>;
 
@@ -86,6 +258,32 @@ auto allocate_unique(Any_allocator, RawAllocator&& allocator, std::size_t size)
 }
 // clang-format on
 
+template <typename T, raw_allocator RawAllocator>
+using joint_ptr = std::unique_ptr<T, Joint_deleter<T, RawAllocator>>;
+
+// Allocates an object together with `joint_size` bytes of trailing memory in a single allocation.
+// The constructor of T gets a Joint_stack as first argument, followed by `args`, and constructs
+// its Joint_array members with it, so the object and its arrays share cache lines.
+// clang-format off
+template <typename T, raw_allocator RawAllocator, typename... Args> requires(not std::is_array_v<T>)
+auto allocate_joint(RawAllocator&& allocator, Joint_size joint_size, Args&&... args)
+        -> joint_ptr<T, typename std::decay_t<RawAllocator>>
+{
+    return detail::allocate_joint<T>(
+            make_allocator_reference(std::forward<RawAllocator>(allocator)), joint_size,
+            std::forward<Args>(args)...);
+}
+
+template <typename T, raw_allocator RawAllocator, typename... Args> requires(not std::is_array_v<T>)
+auto allocate_joint(Any_allocator, RawAllocator&& allocator, Joint_size joint_size, Args&&... args)
+        -> joint_ptr<T, Any_allocator>
+{
+    return detail::allocate_joint<T, Any_allocator>(
+            make_allocator_reference(std::forward<RawAllocator>(allocator)), joint_size,
+            std::forward<Args>(args)...);
+}
+// clang-format on
+
 template <typename T, raw_allocator RawAllocator, typename... Args>
 std::shared_ptr<T> allocate_shared(RawAllocator&& allocator, Args&&... args) {
     return std::allocate_shared<T>(make_std_allocator<T>(std::forward<RawAllocator>(allocator)),
@@ -83,6 +83,11 @@ public:
     constexpr Std_allocator() noexcept requires(not is_stateful_allocator)
             : allocator_reference{allocator_type{}} {}
 
+    // A shared allocator creates a new instance, which is shared by the copies of the container.
+    constexpr Std_allocator() requires(is_stateful_allocator and is_shared_allocator and
+                                       std::default_initializable<allocator_type>)
+            : allocator_reference{allocator_type{}} {}
+
     constexpr explicit Std_allocator(allocator_reference const& allocator) noexcept
             : allocator_reference{allocator} {}
 
@@ -3,6 +3,7 @@
 #include <salt/memory/std_allocator.hpp>
 #include <salt/memory/temporary_allocator.hpp>
 
+#include <thread>
 #include <vector>
 
 template <typename T>
@@ -46,4 +47,41 @@ TEST_CASE("salt::Temporary_allocator", "[salt-memory/temporary_allocator.hpp]")
 
         REQUIRE(1 == v[0].x());
     }
-}
\ No newline at end of file
+}
+
+#if SALT_MEMORY_TEMPORARY_STACK_MODE >= 2
+TEST_CASE("salt::temporary_stack_pool_limit", "[salt-memory/temporary_allocator.hpp]") {
+    // Grows the stack of a new thread, which is retired when the thread exits.
+    auto const use_stack = [](salt::Temporary_stack*& stack, std::size_t& pool_size) {
+        std::thread{[&] {
+            salt::Temporary_allocator allocator;
+            stack     = &allocator.stack();
+            pool_size = salt::temporary_stack_pool_size();
+            for (auto i = 0; i != 8; ++i)
+                allocator.allocate(3u * 1024u, 1u);
+        }}.join();
+    };
+    auto const old_limit = salt::temporary_stack_pool_limit(1024u * 1024u);
+
+    salt::Temporary_stack* first  = nullptr;
+    salt::Temporary_stack* second = nullptr;
+    std::size_t            size   = 0u;
+    use_stack(first, size);
+    auto const pooled = salt::temporary_stack_pool_size();
+    REQUIRE(pooled >= 24u * 1024u);
+
+    // The next thread takes over the grown stack.
+    use_stack(second, size);
+    REQUIRE(second == first);
+    REQUIRE(size == 0u);
+    REQUIRE(salt::temporary_stack_pool_size() == pooled);
+
+    // Without room in the pool the stack keeps only its first block.
+    salt::temporary_stack_pool_limit(0u);
+    use_stack(second, size);
+    REQUIRE(second == first);
+    REQUIRE(salt::temporary_stack_pool_size() == 0u);
+
+    salt::temporary_stack_pool_limit(old_limit);
+}
+#endif
@@ -3,6 +3,7 @@
 #include <salt/foundation/fast_terminate.hpp>
 #include <salt/memory/default_allocator.hpp>
 
+#include <atomic>
 #include <new>
 #include <type_traits>
 
@@ -14,12 +15,14 @@ void default_growth_tracker(std::size_t) noexcept {}
 
 using Temporary_allocator_impl = Default_allocator;
 
+std::atomic<std::size_t> pool_limit{default_temporary_stack_pool_limit};
+
 } // namespace
 
 namespace detail {
 
 Temporary_block_allocator::Temporary_block_allocator(size_type block_size) noexcept
-        : tracker_{default_growth_tracker}, block_size_{block_size} {}
+        : tracker_{default_growth_tracker}, block_size_{block_size}, allocated_{0u} {}
 
 auto Temporary_block_allocator::growth_tracker(growth_tracker_type tracker) noexcept
         -> growth_tracker_type {
@@ -37,6 +40,7 @@ auto Temporary_block_allocator::allocate_block() -> memory_block {
     auto memory    = allocator_traits<Temporary_allocator_impl>::allocate_array(
                allocator, block_size_, 1u, detail::max_alignment);
     auto block  = memory_block{memory, block_size_};
+    allocated_ += block_size_;
     block_size_ = Growing_block_allocator<Temporary_allocator_impl>::new_block_size(block_size_);
     return block;
 }
@@ -45,6 +49,7 @@ void Temporary_block_allocator::deallocate_block(memory_block block) {
     auto allocator = Temporary_allocator_impl{};
     allocator_traits<Temporary_allocator_impl>::deallocate_array(
             allocator, block.memory, block.size, 1u, detail::max_alignment);
+    allocated_ -= block.size;
 }
 
 #if SALT_MEMORY_TEMPORARY_STACK_MODE >= 2
@@ -57,9 +62,13 @@ void Temporary_block_allocator::deallocate_block(memory_block block) {
 //  on program exit the container is iterated and all stack's are properly destroyed
 //  if a thread exit can be detected, the dynamic memory of the stack is already released,
 //  but not the stack itself destroyed
+//  the stack of an exited thread is retired with its blocks, a new thread takes it over instead
+//  of growing a new one, as long as the retired stacks keep less than the pool limit
 
 static struct [[nodiscard]] Temporary_list {
     std::atomic<Temporary_list_node*> first;
+    std::atomic<Temporary_list_node*> retired;
+    std::atomic<std::size_t>          pooled;
 
     Temporary_stack* create_new(std::size_t size) {
         auto storage = Default_allocator{}.allocate_node(sizeof(Temporary_stack),
@@ -67,27 +76,61 @@ static struct [[nodiscard]] Temporary_list {
         return ::new (storage) Temporary_stack{0, size};
     }
 
-    Temporary_stack* find_unused() {
-        for (auto ptr = first.load(); ptr; ptr = ptr->next_) {
-            auto value = false;
-            if (ptr->in_use_.compare_exchange_strong(value, true))
-                return static_cast<Temporary_stack*>(ptr);
-        }
-        return nullptr;
+    // Takes all the retired stacks at once and gives back all but the first one, unlike popping a
+    // single stack this can't take a stack that was claimed and retired again in the meantime.
+    Temporary_stack* claim() noexcept {
+        auto ptr = retired.exchange(nullptr, std::memory_order_acquire);
+        if (!ptr)
+            return nullptr;
+
+        if (auto rest = std::exchange(ptr->next_retired_, nullptr))
+            retire(rest);
+        pooled.fetch_sub(std::exchange(ptr->pooled_, 0u), std::memory_order_relaxed);
+        return static_cast<Temporary_stack*>(ptr);
+    }
+
+    void retire(Temporary_list_node* chain) noexcept {
+        auto last = chain;
+        while (last->next_retired_)
+            last = last->next_retired_;
+
+        last->next_retired_ = retired.load(std::memory_order_relaxed);
+        while (!retired.compare_exchange_weak(last->next_retired_, chain,
+                                              std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    // Accounts `size` bytes to the pool, if they fit in the limit.
+    bool reserve(std::size_t size) noexcept {
+        auto const limit   = pool_limit.load(std::memory_order_relaxed);
+        auto       current = pooled.load(std::memory_order_relaxed);
+        do {
+            if (size > limit || current > limit - size)
+                return false;
+        } while (!pooled.compare_exchange_weak(current, current + size, std::memory_order_relaxed));
+        return true;
     }
 
     Temporary_stack* create(std::size_t size) {
-        if (auto ptr = find_unused()) {
-            SALT_ASSERT(ptr->in_use_);
-            ptr->stack_ = Temporary_block_stack{size};
+        if (auto ptr = claim()) {
+            if (ptr->stack_.allocator().allocated() < size)
+                ptr->stack_ = Temporary_block_stack{size};
             return ptr;
         }
         return create_new(size);
     }
 
     void clear(Temporary_stack& stack) {
-        stack.stack_.shrink_to_fit();
-        stack.in_use_ = false;
+        auto& allocator = stack.stack_.allocator();
+        if (!reserve(allocator.allocated())) {
+            stack.stack_.shrink_to_fit();
+            if (!reserve(allocator.allocated())) {
+                retire(&stack);
+                return;
+            }
+        }
+        stack.pooled_ = allocator.allocated();
+        retire(&stack);
     }
 
     void destroy() {
@@ -100,6 +143,8 @@ static struct [[nodiscard]] Temporary_list {
                                                 alignof(Temporary_stack));
             ptr = next;
         }
+        retired.store(nullptr);
+        pooled.store(0u);
         SALT_ASSERT(!first.load());
     }
 } temporary_stack_list;
@@ -117,17 +162,21 @@ thread_local struct thread_exit_detector_t {
             // and that destructor uses the temporary allocator
             // the stack needs to grow again
             // but who does temporary allocation in a destructor?!
-            temporary_stack_list.clear(*temp_stack);
+            temporary_stack_list.clear(*std::exchange(temp_stack, nullptr));
     }
 } thread_exit_detector;
 
+Temporary_stack* create_stack(std::size_t size) {
+    (void)&thread_exit_detector; // ODR-use it, so it will be created
+    return temporary_stack_list.create(size);
+}
+
 } // namespace
 
-Temporary_list_node::Temporary_list_node(int) noexcept : in_use_{true} {
+Temporary_list_node::Temporary_list_node(int) noexcept {
     next_ = temporary_stack_list.first.load();
     while (!temporary_stack_list.first.compare_exchange_weak(next_, this))
         ;
-    (void)&thread_exit_detector; // ODR-use it, so it will be created
 }
 
 Temporary_allocator_dtor::Temporary_allocator_dtor() noexcept {
@@ -135,7 +184,7 @@ Temporary_allocator_dtor::Temporary_allocator_dtor() noexcept {
 }
 
 Temporary_allocator_dtor::~Temporary_allocator_dtor() {
-    if (--nifty_counter == 0u && temp_stack)
+    if (--nifty_counter == 0u && temporary_stack_list.first.load())
         temporary_stack_list.destroy();
 }
 #endif
@@ -146,23 +195,27 @@ Temporary_allocator_dtor::~Temporary_allocator_dtor() {
 Temporary_stack_initializer::Temporary_stack_initializer(std::size_t size) {
     using namespace detail;
     if (!temp_stack)
-        temp_stack = temporary_stack_list.create(size);
+        temp_stack = create_stack(size);
 }
 
 Temporary_stack_initializer::~Temporary_stack_initializer() {
     using namespace detail;
     // don't destroy, nifty counter does that
-    // but can get rid of all the memory
+    // but retire it, so another thread can take it over
     if (temp_stack)
-        temporary_stack_list.clear(*temp_stack);
+        temporary_stack_list.clear(*std::exchange(temp_stack, nullptr));
 }
 
 Temporary_stack& temporary_stack(std::size_t size) {
     using namespace detail;
     if (!temp_stack)
-        temp_stack = temporary_stack_list.create(size);
+        temp_stack = create_stack(size);
     return *temp_stack;
 }
+
+std::size_t temporary_stack_pool_size() noexcept {
+    return detail::temporary_stack_list.pooled.load(std::memory_order_relaxed);
+}
 #elif SALT_MEMORY_TEMPORARY_STACK_MODE == 1
 // NOTE:
 //  Explicit lifetime managment
@@ -200,6 +253,10 @@ Temporary_stack& temporary_stack(std::size_t size) {
     return stack();
 }
 
+std::size_t temporary_stack_pool_size() noexcept {
+    return 0u;
+}
+
 #else
 // NOTE:
 //  No lifetime managment
@@ -213,8 +270,20 @@ Temporary_stack& temporary_stack(std::size_t) {
                 "SALT_MEMORY_TEMPORARY_STACK_MODE == 0");
     fast_terminate();
 }
+
+std::size_t temporary_stack_pool_size() noexcept {
+    return 0u;
+}
 #endif
 
+std::size_t temporary_stack_pool_limit(std::size_t limit) noexcept {
+    return pool_limit.exchange(limit, std::memory_order_relaxed);
+}
+
+std::size_t temporary_stack_pool_limit() noexcept {
+    return pool_limit.load(std::memory_order_relaxed);
+}
+
 Temporary_stack_initializer::Defer_create const Temporary_stack_initializer::defer_create;
 
 Temporary_allocator::Temporary_allocator() : Temporary_allocator{temporary_stack()} {}
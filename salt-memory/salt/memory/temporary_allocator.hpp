@@ -4,10 +4,6 @@
 #include <salt/memory/memory_block.hpp>
 #include <salt/memory/memory_stack.hpp>
 
-#if SALT_MEMORY_TEMPORARY_STACK_MODE >= 2
-#    include <atomic>
-#endif
-
 namespace salt {
 
 class [[nodiscard]] Temporary_allocator;
@@ -35,9 +31,15 @@ struct [[nodiscard]] Temporary_block_allocator {
 
     growth_tracker_type growth_tracker() noexcept;
 
+    // The size of all the blocks that are not deallocated, including the cached ones.
+    size_type allocated() const noexcept {
+        return allocated_;
+    }
+
 private:
     growth_tracker_type tracker_;
     size_type           block_size_;
+    size_type           allocated_;
 };
 
 struct [[nodiscard]] Temporary_list;
@@ -46,15 +48,16 @@ using Temporary_block_stack = Memory_stack<Temporary_block_allocator>;
 
 #if SALT_MEMORY_TEMPORARY_STACK_MODE >= 2
 struct [[nodiscard]] Temporary_list_node {
-    Temporary_list_node() noexcept : in_use_{true} {}
+    Temporary_list_node() noexcept = default;
 
     explicit Temporary_list_node(int) noexcept;
 
     ~Temporary_list_node() = default;
 
 private:
-    Temporary_list_node* next_ = nullptr;
-    std::atomic_bool     in_use_;
+    Temporary_list_node* next_         = nullptr;
+    Temporary_list_node* next_retired_ = nullptr;
+    std::size_t          pooled_       = 0u;
 
     friend Temporary_list;
 };
@@ -150,6 +153,22 @@ struct [[nodiscard]] Temporary_stack_initializer {
     Temporary_stack_initializer& operator=(Temporary_stack_initializer&&) = delete;
 };
 
+// The default number of bytes the per-thread stacks of exited threads keep for new threads.
+static constexpr inline std::size_t default_temporary_stack_pool_limit = 1024u * 1024u;
+
+// Sets the number of bytes the per-thread stacks of exited threads may keep for new threads, it
+// returns the previous limit. A new thread takes over a retired stack with its grown blocks instead
+// of growing a new one, a stack that exceeds the limit gives its cached blocks back.
+// NOTE:
+//  * Only `SALT_TEMPORARY_STACK_MODE == 2` recycles the stacks, otherwise the limit has no effect.
+//  * Lowering the limit doesn't release the memory the retired stacks already keep.
+std::size_t temporary_stack_pool_limit(std::size_t limit) noexcept;
+
+std::size_t temporary_stack_pool_limit() noexcept;
+
+// Returns the number of bytes the retired per-thread stacks currently keep.
+std::size_t temporary_stack_pool_size() noexcept;
+
 // Creates the per-thread Temporary_stack with the given initial size, if it wasn't already created.
 // NOTE:
 //  There must be a per-thread temporary stack (SALT_TEMPORARY_STACK_MODE must not be equal to `0`).
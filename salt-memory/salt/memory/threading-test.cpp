@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/allocator_storage.hpp>
+#include <salt/memory/memory_pool.hpp>
+#include <salt/memory/threading.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace salt;
+
+namespace {
+
+template <typename Mutex> void test_mutex() {
+    Mutex       mutex;
+    std::size_t counter = 0u;
+
+    REQUIRE(mutex.try_lock());
+    REQUIRE(!mutex.try_lock());
+    mutex.unlock();
+
+    std::vector<std::jthread> threads;
+    for (auto i = 0; i != 4; ++i)
+        threads.emplace_back([&] {
+            for (auto j = 0; j != 10000; ++j) {
+                std::lock_guard lock{mutex};
+                ++counter;
+            }
+        });
+    threads.clear();
+    REQUIRE(counter == 40000u);
+}
+
+} // namespace
+
+TEST_CASE("salt::Spin_mutex", "[salt-memory/threading.hpp]") {
+    test_mutex<Spin_mutex>();
+}
+
+TEST_CASE("salt::Adaptive_mutex", "[salt-memory/threading.hpp]") {
+    test_mutex<Adaptive_mutex>();
+
+    using storage = Allocator_storage<Direct_storage<Memory_pool<>>, Adaptive_mutex>;
+    storage allocator{Memory_pool<>{16u, 4096u}};
+
+    std::vector<std::jthread> threads;
+    for (auto i = 0; i != 4; ++i)
+        threads.emplace_back([&] {
+            for (auto j = 0; j != 1000; ++j)
+                allocator.deallocate_node(allocator.allocate_node(16u, 8u), 16u, 8u);
+        });
+}
+
+TEST_CASE("salt::Sharded_allocator_storage", "[salt-memory/threading.hpp]") {
+    using storage = Sharded_allocator_storage<Memory_pool<>, Spin_mutex, 4u>;
+    storage allocator{16u, 4096u};
+    REQUIRE(storage::shard_count == 4u);
+    REQUIRE(storage::current_shard() < 4u);
+    REQUIRE(allocator.max_node_size() == 16u);
+    REQUIRE(alignof(decltype(allocator)) >= 64u);
+
+    // Memory allocated by one thread is deallocated by another one.
+    std::vector<void*> nodes(4000u);
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t i = 0u; i != 4u; ++i)
+            threads.emplace_back([&, i] {
+                for (std::size_t j = 0u; j != 1000u; ++j)
+                    nodes[i * 1000u + j] = allocator.allocate_node(16u, 8u);
+            });
+    }
+    std::ranges::sort(nodes);
+    REQUIRE(std::ranges::adjacent_find(nodes) == nodes.end());
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t i = 0u; i != 4u; ++i)
+            threads.emplace_back([&, i] {
+                for (std::size_t j = i; j < nodes.size(); j += 4u)
+                    allocator.deallocate_node(nodes[j], 16u, 8u);
+            });
+    }
+    for (std::size_t i = 0u; i != 4u; ++i) {
+        std::lock_guard lock{allocator.mutex(i)};
+        REQUIRE(allocator.allocator(i).capacity() > 0u);
+    }
+}
@@ -1,10 +1,18 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
+#include <utility>
 
 #include <salt/config.hpp>
 #include <salt/foundation/logger.hpp>
 #include <salt/memory/allocator_traits.hpp>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    include <immintrin.h>
+#endif
+
 namespace salt {
 
 // A dummy Mutex class that does not lock anything. It is a valid Mutex and can be used to disable
@@ -21,6 +29,99 @@ struct [[nodiscard]] No_mutex final {
 // clang-format on
 using no_mutex = No_mutex;
 
+namespace detail {
+
+// Tells the CPU that the thread is busy waiting, so the other hyper-thread of the core can run.
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// The size of the cache line that the shards of a Sharded_allocator_storage are aligned to.
+static constexpr inline std::size_t cache_line_size = 64u;
+
+// A small number that identifies the calling thread, the threads are numbered in the order they
+// first call it.
+inline std::size_t thread_index() noexcept {
+    static constinit std::atomic<std::size_t> next_index{0u};
+    thread_local auto const index = next_index.fetch_add(1u, std::memory_order_relaxed);
+    return index;
+}
+
+} // namespace detail
+
+// A Mutex that busy waits until it is unlocked. It never puts the thread to sleep, so it is only
+// suitable for short critical sections like the ones of an allocator.
+class [[nodiscard]] Spin_mutex final {
+public:
+    void lock() noexcept {
+        while (locked_.exchange(true, std::memory_order_acquire))
+            while (locked_.load(std::memory_order_relaxed))
+                detail::cpu_relax();
+    }
+
+    bool try_lock() noexcept {
+        return !locked_.load(std::memory_order_relaxed) &&
+               !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept {
+        locked_.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> locked_{false};
+};
+
+// The number of times an Adaptive_mutex checks the lock before it puts the thread to sleep.
+static constexpr inline std::size_t adaptive_mutex_spin_count = 128u;
+
+// A Mutex that busy waits for a short time and then sleeps until it is unlocked. The sleeping is
+// done with std::atomic::wait, which is a futex on Linux, so an uncontended lock and unlock are a
+// single atomic operation and only an unlock with sleeping waiters makes a system call.
+class [[nodiscard]] Adaptive_mutex final {
+public:
+    void lock() noexcept {
+        if (!try_lock()) [[unlikely]]
+            lock_contended();
+    }
+
+    bool try_lock() noexcept {
+        auto expected = unlocked;
+        return state_.compare_exchange_strong(expected, locked, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        if (state_.exchange(unlocked, std::memory_order_release) == contended) [[unlikely]]
+            state_.notify_one();
+    }
+
+private:
+    // clang-format off
+    static constexpr std::uint32_t unlocked  = 0u;
+    static constexpr std::uint32_t locked    = 1u;
+    static constexpr std::uint32_t contended = 2u;
+    // clang-format on
+
+    void lock_contended() noexcept {
+        for (std::size_t spin = 0u; spin != adaptive_mutex_spin_count; ++spin) {
+            if (state_.load(std::memory_order_relaxed) == unlocked && try_lock())
+                return;
+            detail::cpu_relax();
+        }
+
+        // The lock is marked as contended while a thread sleeps, so the unlock wakes it up.
+        while (state_.exchange(contended, std::memory_order_acquire) != unlocked)
+            state_.wait(contended, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint32_t> state_{unlocked};
+};
+
 template <typename RawAllocator>
 concept thread_safe_allocator = not allocator_traits<RawAllocator>::is_stateful::value;
 template <typename Allocator>
@@ -128,4 +229,134 @@ using lock_guard_for =
         std::conditional_t<std::same_as<Mutex, No_mutex>, detail::Dummy_guard<MutexStorage>,
                            std::lock_guard<MutexStorage>>;
 
+// A RawAllocator whose owner of a piece of memory can be found with composable_traits.
+// clang-format off
+template <typename RawAllocator>
+concept shardable_allocator = raw_allocator<RawAllocator> and
+    requires(typename allocator_traits<RawAllocator>::allocator_type& allocator, void* memory,
+             std::size_t size)
+    {
+        { composable_traits<RawAllocator>::try_deallocate_node(allocator, memory, size, size) }
+            -> std::same_as<bool>;
+    };
+// clang-format on
+
+// Stripes one logical allocator across `Shards` instances, each with its own Mutex. A thread
+// allocates from the instance selected by its thread index, so threads rarely contend for a lock.
+// Memory can be deallocated by any thread, the instance owning it is found with the composable
+// traits of the allocator, starting with the instance of the calling thread.
+// NOTE:
+//  * Every instance is constructed with the same arguments.
+//  * The instances are aligned to cache lines, so they don't share a cache line.
+template <shardable_allocator RawAllocator, typename Mutex = Adaptive_mutex,
+          std::size_t Shards = 8u>
+class [[nodiscard]] Sharded_allocator_storage {
+    static_assert(Shards > 0u, "Sharded_allocator_storage needs at least one shard");
+
+    using allocator_traits  = allocator_traits<RawAllocator>;
+    using composable_traits = composable_traits<RawAllocator>;
+
+public:
+    using allocator_type  = typename allocator_traits::allocator_type;
+    using mutex_type      = Mutex;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_stateful     = std::true_type;
+
+    static constexpr size_type shard_count = Shards;
+
+    template <typename... Args>
+    explicit Sharded_allocator_storage(Args const&... args)
+            : Sharded_allocator_storage{std::make_index_sequence<Shards>{}, args...} {}
+
+    Sharded_allocator_storage(Sharded_allocator_storage&&)            = delete;
+    Sharded_allocator_storage& operator=(Sharded_allocator_storage&&) = delete;
+
+    void* allocate_node(size_type size, size_type alignment) {
+        auto&           shard = this_shard();
+        std::lock_guard lock{shard.mutex};
+        return allocator_traits::allocate_node(shard.allocator, size, alignment);
+    }
+
+    void* allocate_array(size_type count, size_type size, size_type alignment) {
+        auto&           shard = this_shard();
+        std::lock_guard lock{shard.mutex};
+        return allocator_traits::allocate_array(shard.allocator, count, size, alignment);
+    }
+
+    void deallocate_node(void* node, size_type size, size_type alignment) noexcept {
+        [[maybe_unused]] auto const owned = for_each_shard([&](Shard& shard) {
+            return composable_traits::try_deallocate_node(shard.allocator, node, size, alignment);
+        });
+        SALT_ASSERT(owned);
+    }
+
+    void deallocate_array(void* array, size_type count, size_type size,
+                          size_type alignment) noexcept {
+        [[maybe_unused]] auto const owned = for_each_shard([&](Shard& shard) {
+            return composable_traits::try_deallocate_array(shard.allocator, array, count, size,
+                                                           alignment);
+        });
+        SALT_ASSERT(owned);
+    }
+
+    size_type max_node_size() const noexcept {
+        return allocator_traits::max_node_size(shards_[0].allocator);
+    }
+
+    size_type max_array_size() const noexcept {
+        return allocator_traits::max_array_size(shards_[0].allocator);
+    }
+
+    size_type max_alignment() const noexcept {
+        return allocator_traits::max_alignment(shards_[0].allocator);
+    }
+
+    // Returns the instance of the given shard, it must only be used while the shard is locked.
+    allocator_type& allocator(size_type shard) noexcept {
+        SALT_ASSERT(shard < Shards);
+        return shards_[shard].allocator;
+    }
+
+    mutex_type& mutex(size_type shard) const noexcept {
+        SALT_ASSERT(shard < Shards);
+        return shards_[shard].mutex;
+    }
+
+    // Returns the shard the calling thread allocates from.
+    static size_type current_shard() noexcept {
+        return detail::thread_index() % Shards;
+    }
+
+private:
+    struct alignas(detail::cache_line_size) [[nodiscard]] Shard final {
+        template <typename... Args> explicit Shard(Args const&... args) : allocator{args...} {}
+
+        allocator_type allocator;
+        mutable Mutex  mutex;
+    };
+
+    template <std::size_t... Indices, typename... Args>
+    explicit Sharded_allocator_storage(std::index_sequence<Indices...>, Args const&... args)
+            : shards_{{(void(Indices), Shard{args...})...}} {}
+
+    Shard& this_shard() noexcept {
+        return shards_[current_shard()];
+    }
+
+    // Calls `f` with each locked shard until it returns true, returns false if it never does.
+    template <typename Function> bool for_each_shard(Function&& f) noexcept {
+        auto const first = current_shard();
+        for (size_type i = 0u; i != Shards; ++i) {
+            auto&           shard = shards_[(first + i) % Shards];
+            std::lock_guard lock{shard.mutex};
+            if (f(shard))
+                return true;
+        }
+        return false;
+    }
+
+    std::array<Shard, Shards> shards_;
+};
+
 } // namespace salt
@@ -0,0 +1,106 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/detail/align.hpp>
+#include <salt/memory/memory_arena.hpp>
+#include <salt/memory/virtual_memory.hpp>
+
+#include <cstring>
+
+using namespace salt;
+
+TEST_CASE("salt::virtual_memory", "[salt-memory/virtual_memory.hpp]") {
+    auto const page_size = virtual_memory_page_size();
+    REQUIRE(page_size != 0u);
+    REQUIRE(detail::is_pow2(page_size));
+
+    auto pages = static_cast<std::byte*>(virtual_memory_reserve(5u));
+    REQUIRE(pages);
+    REQUIRE(detail::is_aligned(pages, page_size));
+
+    SECTION("commit") {
+        auto memory = virtual_memory_commit(pages + page_size, 3u);
+        REQUIRE(memory == pages + page_size);
+        std::memset(memory, 0xFF, 3u * page_size);
+        virtual_memory_decommit(memory, 3u);
+    }
+    SECTION("commit again") {
+        auto memory = virtual_memory_commit(pages, 1u);
+        REQUIRE(memory == pages);
+        std::memset(memory, 0xFF, page_size);
+        virtual_memory_decommit(memory, 1u);
+
+        // The content of decommitted memory is discarded.
+        memory = virtual_memory_commit(pages, 1u);
+        REQUIRE(memory == pages);
+        REQUIRE(*static_cast<unsigned char*>(memory) == 0u);
+        virtual_memory_decommit(memory, 1u);
+    }
+
+    virtual_memory_release(pages, 5u);
+}
+
+TEST_CASE("salt::Virtual_block_allocator", "[salt-memory/virtual_memory.hpp]") {
+    auto const page_size = virtual_memory_page_size();
+
+    Virtual_block_allocator allocator(page_size + 1u, 3u);
+    REQUIRE(allocator.block_size() == 2u * page_size);
+    REQUIRE(allocator.capacity_left() == 3u);
+
+    auto block1 = allocator.allocate_block();
+    auto block2 = allocator.allocate_block();
+    REQUIRE(block1.size == 2u * page_size);
+    REQUIRE(static_cast<std::byte*>(block2.memory) ==
+            static_cast<std::byte*>(block1.memory) + block1.size);
+    std::memset(block2.memory, 0xFF, block2.size);
+    REQUIRE(allocator.capacity_left() == 1u);
+
+    // A block allocated again has the same address.
+    allocator.deallocate_block(block2);
+    auto block3 = allocator.allocate_block();
+    REQUIRE(block3.memory == block2.memory);
+
+    auto block4 = allocator.allocate_block();
+    REQUIRE(allocator.capacity_left() == 0u);
+    REQUIRE_THROWS_AS(allocator.allocate_block(), std::bad_alloc);
+
+    auto moved = std::move(allocator);
+    moved.deallocate_block(block4);
+    moved.deallocate_block(block3);
+    moved.deallocate_block(block1);
+}
+
+TEST_CASE("salt::Numa_block_allocator", "[salt-memory/virtual_memory.hpp]") {
+    auto const page_size = virtual_memory_page_size();
+    REQUIRE(numa_node_count() >= 1u);
+    REQUIRE(numa_current_node() < numa_node_count());
+
+    Numa_block_allocator allocator(page_size, 2u);
+    REQUIRE(allocator.block_size() == page_size);
+    REQUIRE(allocator.node_count() >= 1u);
+    REQUIRE(allocator.current_node() < allocator.node_count());
+
+    // The blocks are allocated on the node of the thread, as long as it has blocks left.
+    auto const node   = allocator.current_node();
+    auto       block1 = allocator.allocate_block();
+    auto       block2 = allocator.allocate_block();
+    REQUIRE(allocator.node_of(block1) == node);
+    REQUIRE(allocator.node_of({static_cast<std::byte*>(block2.memory) + 8u, 8u}) == node);
+    std::memset(block2.memory, 0xFF, block2.size);
+
+    if (allocator.node_count() == 1u)
+        REQUIRE_THROWS_AS(allocator.allocate_block(), std::bad_alloc);
+
+    allocator.deallocate_block(block2);
+    allocator.deallocate_block(block1);
+
+    SECTION("arena") {
+        Memory_arena<Numa_block_allocator> arena{page_size, 4u};
+        auto const                         block = arena.allocate_block();
+        arena.deallocate_block();
+        REQUIRE(arena.cache_size() == 1u);
+
+        // The cached block is reused on the same node.
+        REQUIRE(arena.allocate_block().memory == block.memory);
+        REQUIRE(arena.cache_size() == 0u);
+    }
+}
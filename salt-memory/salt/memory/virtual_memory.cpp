@@ -0,0 +1,367 @@
+#include <salt/memory/virtual_memory.hpp>
+
+#include <salt/config.hpp>
+#include <salt/foundation/logger.hpp>
+#include <salt/memory/debugging.hpp>
+#include <salt/memory/detail/debug_helpers.hpp>
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#if SALT_TARGET(WINDOWS)
+#    define WIN32_LEAN_AND_MEAN
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <sys/mman.h>
+#    include <unistd.h>
+#    if SALT_TARGET(LINUX)
+#        include <sys/syscall.h>
+
+#        include <cstdio>
+#    endif
+#endif
+
+namespace salt {
+
+#if SALT_TARGET(WINDOWS)
+std::size_t virtual_memory_page_size() noexcept {
+    static std::size_t const page_size = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return std::size_t(info.dwPageSize);
+    }();
+    return page_size;
+}
+
+void* virtual_memory_reserve(std::size_t no_pages) noexcept {
+    return VirtualAlloc(nullptr, no_pages * virtual_memory_page_size(), MEM_RESERVE,
+                        PAGE_READWRITE);
+}
+
+void virtual_memory_release(void* pages, std::size_t) noexcept {
+    [[maybe_unused]] auto const result = VirtualFree(pages, 0u, MEM_RELEASE);
+    SALT_ASSERT(result);
+}
+
+void* virtual_memory_commit(void* memory, std::size_t no_pages) noexcept {
+    return VirtualAlloc(memory, no_pages * virtual_memory_page_size(), MEM_COMMIT,
+                        PAGE_READWRITE);
+}
+
+void virtual_memory_decommit(void* memory, std::size_t no_pages) noexcept {
+    [[maybe_unused]] auto const result =
+            VirtualFree(memory, no_pages * virtual_memory_page_size(), MEM_DECOMMIT);
+    SALT_ASSERT(result);
+}
+
+std::size_t numa_node_count() noexcept {
+    static std::size_t const count = [] {
+        ULONG highest = 0u;
+        return GetNumaHighestNodeNumber(&highest) ? std::size_t(highest) + 1u : 1u;
+    }();
+    return count;
+}
+
+std::size_t numa_current_node() noexcept {
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    USHORT node = 0u;
+    return GetNumaProcessorNodeEx(&processor, &node) ? std::size_t(node) : 0u;
+}
+
+void* virtual_memory_commit_on_node(void* memory, std::size_t no_pages, std::size_t node) noexcept {
+    if (numa_node_count() == 1u)
+        return virtual_memory_commit(memory, no_pages);
+    return VirtualAllocExNuma(GetCurrentProcess(), memory, no_pages * virtual_memory_page_size(),
+                              MEM_COMMIT, PAGE_READWRITE, DWORD(node));
+}
+#else
+std::size_t virtual_memory_page_size() noexcept {
+    static std::size_t const page_size = std::size_t(::sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+void* virtual_memory_reserve(std::size_t no_pages) noexcept {
+    auto pages = ::mmap(nullptr, no_pages * virtual_memory_page_size(), PROT_NONE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return pages == MAP_FAILED ? nullptr : pages;
+}
+
+void virtual_memory_release(void* pages, std::size_t no_pages) noexcept {
+    [[maybe_unused]] auto const result = ::munmap(pages, no_pages * virtual_memory_page_size());
+    SALT_ASSERT(result == 0);
+}
+
+void* virtual_memory_commit(void* memory, std::size_t no_pages) noexcept {
+    auto const size   = no_pages * virtual_memory_page_size();
+    auto const result = ::mprotect(memory, size, PROT_READ | PROT_WRITE);
+    if (result != 0)
+        return nullptr;
+
+    // Advise that the memory will be needed.
+#    if defined(MADV_WILLNEED)
+    ::madvise(memory, size, MADV_WILLNEED);
+#    endif
+    return memory;
+}
+
+void virtual_memory_decommit(void* memory, std::size_t no_pages) noexcept {
+    auto const size = no_pages * virtual_memory_page_size();
+    // Advise that the memory won't be needed anymore, so the kernel can drop its content.
+    ::madvise(memory, size, MADV_DONTNEED);
+    [[maybe_unused]] auto const result = ::mprotect(memory, size, PROT_NONE);
+    SALT_ASSERT(result == 0);
+}
+
+#    if SALT_TARGET(LINUX)
+std::size_t numa_node_count() noexcept {
+    static std::size_t const count = [] {
+        // The possible nodes are listed as a range, e.g. "0-1", or as "0" without NUMA.
+        auto file = std::fopen("/sys/devices/system/node/possible", "r");
+        if (!file)
+            return std::size_t(1u);
+
+        unsigned first = 0u, last = 0u;
+        auto const ranges = std::fscanf(file, "%u-%u", &first, &last);
+        std::fclose(file);
+        return ranges == 2 ? std::size_t(last) + 1u : std::size_t(1u);
+    }();
+    return count;
+}
+
+std::size_t numa_current_node() noexcept {
+    unsigned cpu = 0u, node = 0u;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+        return 0u;
+    return node;
+}
+
+void* virtual_memory_commit_on_node(void* memory, std::size_t no_pages, std::size_t node) noexcept {
+    auto const result = virtual_memory_commit(memory, no_pages);
+    if (!result || numa_node_count() == 1u || node >= 8u * sizeof(unsigned long))
+        return result;
+
+    // The pages are not touched yet, so they are placed on the preferred node when they are. The
+    // kernel reads one bit less than the given number of nodes.
+    constexpr auto preferred = 1;
+    auto const     mask      = 1ul << node;
+    ::syscall(SYS_mbind, memory, no_pages * virtual_memory_page_size(), preferred, &mask,
+              8u * sizeof(mask) + 1u, 0u);
+    return result;
+}
+#    else
+std::size_t numa_node_count() noexcept {
+    return 1u;
+}
+
+std::size_t numa_current_node() noexcept {
+    return 0u;
+}
+
+void* virtual_memory_commit_on_node(void* memory, std::size_t no_pages, std::size_t) noexcept {
+    return virtual_memory_commit(memory, no_pages);
+}
+#    endif
+#endif
+
+namespace detail {
+
+namespace {
+
+std::size_t round_to_pages(std::size_t size) noexcept {
+    auto const page_size = virtual_memory_page_size();
+    return (size + page_size - 1u) / page_size * page_size;
+}
+
+} // namespace
+
+Virtual_buffer::Virtual_buffer(size_type max_size) : reserved_{round_to_pages(max_size)} {
+    if (reserved_ == 0u)
+        return;
+
+    data_ = static_cast<std::byte*>(virtual_memory_reserve(reserved_ / virtual_memory_page_size()));
+    if (!data_)
+        throw std::bad_alloc();
+}
+
+Virtual_buffer::~Virtual_buffer() {
+    if (data_)
+        virtual_memory_release(data_, reserved_ / virtual_memory_page_size());
+}
+
+Virtual_buffer::Virtual_buffer(Virtual_buffer&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          committed_{std::exchange(other.committed_, 0u)},
+          reserved_{std::exchange(other.reserved_, 0u)} {}
+
+Virtual_buffer& Virtual_buffer::operator=(Virtual_buffer&& other) noexcept {
+    Virtual_buffer tmp{std::move(other)};
+    std::swap(data_, tmp.data_);
+    std::swap(committed_, tmp.committed_);
+    std::swap(reserved_, tmp.reserved_);
+    return *this;
+}
+
+void Virtual_buffer::commit(size_type size) {
+    if (size <= committed_)
+        return;
+    if (size > reserved_)
+        throw std::bad_alloc();
+
+    auto const new_committed = round_to_pages(size);
+    auto const no_pages      = (new_committed - committed_) / virtual_memory_page_size();
+    if (!virtual_memory_commit(data_ + committed_, no_pages))
+        throw std::bad_alloc();
+    committed_ = new_committed;
+}
+
+void Virtual_buffer::decommit(size_type size) noexcept {
+    auto const new_committed = round_to_pages(size);
+    if (new_committed >= committed_)
+        return;
+
+    virtual_memory_decommit(data_ + new_committed,
+                            (committed_ - new_committed) / virtual_memory_page_size());
+    committed_ = new_committed;
+}
+
+} // namespace detail
+
+namespace {
+
+Allocator_info virtual_block_allocator_info(void const* allocator) noexcept {
+    return {"salt::Virtual_block_allocator", allocator};
+}
+
+} // namespace
+
+Virtual_block_allocator::Virtual_block_allocator(size_type block_size, size_type block_count) {
+    auto const page_size = virtual_memory_page_size();
+    block_size_          = (block_size + page_size - 1u) / page_size * page_size;
+
+    auto const no_pages = block_count * (block_size_ / page_size);
+    begin_              = static_cast<std::byte*>(virtual_memory_reserve(no_pages));
+    if (!begin_)
+        throw std::bad_alloc();
+    current_ = begin_;
+    end_     = begin_ + no_pages * page_size;
+}
+
+Virtual_block_allocator::~Virtual_block_allocator() {
+    if (begin_)
+        virtual_memory_release(begin_, size_type(end_ - begin_) / virtual_memory_page_size());
+}
+
+Virtual_block_allocator::Virtual_block_allocator(Virtual_block_allocator&& other) noexcept
+        : begin_{std::exchange(other.begin_, nullptr)},
+          current_{std::exchange(other.current_, nullptr)},
+          end_{std::exchange(other.end_, nullptr)}, block_size_{other.block_size_} {}
+
+Virtual_block_allocator&
+Virtual_block_allocator::operator=(Virtual_block_allocator&& other) noexcept {
+    Virtual_block_allocator tmp{std::move(other)};
+    std::swap(begin_, tmp.begin_);
+    std::swap(current_, tmp.current_);
+    std::swap(end_, tmp.end_);
+    std::swap(block_size_, tmp.block_size_);
+    return *this;
+}
+
+Memory_block Virtual_block_allocator::allocate_block() {
+    if (current_ == end_)
+        throw std::bad_alloc();
+
+    auto const memory = virtual_memory_commit(current_, block_size_ / virtual_memory_page_size());
+    if (!memory)
+        throw std::bad_alloc();
+    current_ += block_size_;
+    return {memory, block_size_};
+}
+
+void Virtual_block_allocator::deallocate_block(Memory_block block) noexcept {
+    detail::debug_check_pointer(
+            [&] {
+                return block.memory == current_ - block_size_;
+            },
+            virtual_block_allocator_info(this), block.memory);
+    current_ -= block_size_;
+    virtual_memory_decommit(current_, block_size_ / virtual_memory_page_size());
+}
+
+namespace {
+
+Allocator_info numa_block_allocator_info(void const* allocator) noexcept {
+    return {"salt::Numa_block_allocator", allocator};
+}
+
+} // namespace
+
+Numa_block_allocator::Numa_block_allocator(size_type block_size, size_type block_count)
+        : node_count_{std::min(numa_node_count(), max_nodes)} {
+    auto const page_size = virtual_memory_page_size();
+    block_size_          = (block_size + page_size - 1u) / page_size * page_size;
+    node_size_           = block_count * block_size_;
+
+    begin_ = static_cast<std::byte*>(virtual_memory_reserve(node_count_ * node_size_ / page_size));
+    if (!begin_)
+        throw std::bad_alloc();
+    for (size_type node = 0u; node != node_count_; ++node)
+        current_[node] = begin_ + node * node_size_;
+}
+
+Numa_block_allocator::~Numa_block_allocator() {
+    if (begin_)
+        virtual_memory_release(begin_, node_count_ * node_size_ / virtual_memory_page_size());
+}
+
+Numa_block_allocator::Numa_block_allocator(Numa_block_allocator&& other) noexcept
+        : begin_{std::exchange(other.begin_, nullptr)}, block_size_{other.block_size_},
+          node_size_{other.node_size_}, node_count_{other.node_count_} {
+    std::ranges::copy(other.current_, current_);
+}
+
+Numa_block_allocator& Numa_block_allocator::operator=(Numa_block_allocator&& other) noexcept {
+    Numa_block_allocator tmp{std::move(other)};
+    std::swap(begin_, tmp.begin_);
+    std::swap(block_size_, tmp.block_size_);
+    std::swap(node_size_, tmp.node_size_);
+    std::swap(node_count_, tmp.node_count_);
+    std::swap(current_, tmp.current_);
+    return *this;
+}
+
+Memory_block Numa_block_allocator::allocate_block() {
+    // A node that ran out of blocks borrows them from the next nodes.
+    auto const first = current_node();
+    for (size_type i = 0u; i != node_count_; ++i) {
+        auto const node = (first + i) % node_count_;
+        if (current_[node] == begin_ + (node + 1u) * node_size_)
+            continue;
+
+        auto const memory = virtual_memory_commit_on_node(
+                current_[node], block_size_ / virtual_memory_page_size(), node);
+        if (!memory)
+            throw std::bad_alloc();
+        current_[node] += block_size_;
+        return {memory, block_size_};
+    }
+    throw std::bad_alloc();
+}
+
+void Numa_block_allocator::deallocate_block(Memory_block block) noexcept {
+    // The blocks of a node are deallocated in reverse order, like all blocks of a Memory_arena.
+    auto const node = node_of(block);
+    detail::debug_check_pointer(
+            [&] {
+                return block.memory == current_[node] - block_size_;
+            },
+            numa_block_allocator_info(this), block.memory);
+    current_[node] -= block_size_;
+    virtual_memory_decommit(current_[node], block_size_ / virtual_memory_page_size());
+}
+
+} // namespace salt
@@ -0,0 +1,179 @@
+#pragma once
+#include <salt/memory/memory_block.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace salt {
+
+// The page size of the virtual memory. All virtual memory allocations must be multiple of this
+// size. It is usually 4KiB.
+std::size_t virtual_memory_page_size() noexcept;
+
+// Reserves virtual memory. It returns the address of the first reserved page, or nullptr in case of
+// error. The memory has to be committed before it can be used.
+void* virtual_memory_reserve(std::size_t no_pages) noexcept;
+
+// Releases reserved virtual memory. The pages must have been previously reserved with
+// `virtual_memory_reserve` and `no_pages` must be the same number of pages.
+void virtual_memory_release(void* pages, std::size_t no_pages) noexcept;
+
+// Commits reserved virtual memory. It returns the address of the committed memory, or nullptr in
+// case of error. After it the memory can be read and written.
+void* virtual_memory_commit(void* memory, std::size_t no_pages) noexcept;
+
+// Decommits committed virtual memory. The pages become inaccessible again and their content is
+// discarded, but they are still reserved.
+void virtual_memory_decommit(void* memory, std::size_t no_pages) noexcept;
+
+// The number of NUMA nodes of the system, it is 1 if the system or the platform has no NUMA.
+std::size_t numa_node_count() noexcept;
+
+// The NUMA node of the CPU the calling thread runs on, it is only stable for pinned threads.
+std::size_t numa_current_node() noexcept;
+
+// Commits reserved virtual memory like `virtual_memory_commit` and prefers the physical memory of
+// the given NUMA node for it. Without NUMA it only commits the memory.
+void* virtual_memory_commit_on_node(void* memory, std::size_t no_pages, std::size_t node) noexcept;
+
+namespace detail {
+
+// A range of reserved virtual memory whose beginning is committed. It grows by committing the pages
+// that follow the committed ones, so the memory never moves.
+class [[nodiscard]] Virtual_buffer {
+public:
+    using size_type = std::size_t;
+
+    Virtual_buffer() noexcept = default;
+
+    // Reserves `max_size` bytes rounded up to a multiple of the page size, nothing is committed.
+    explicit Virtual_buffer(size_type max_size);
+
+    ~Virtual_buffer();
+
+    Virtual_buffer(Virtual_buffer&& other) noexcept;
+
+    Virtual_buffer& operator=(Virtual_buffer&& other) noexcept;
+
+    // Commits at least the first `size` bytes, it throws std::bad_alloc if they are not reserved or
+    // can't be committed.
+    void commit(size_type size);
+
+    // Decommits the pages after the first `size` bytes.
+    void decommit(size_type size) noexcept;
+
+    std::byte* data() const noexcept {
+        return data_;
+    }
+
+    size_type committed() const noexcept {
+        return committed_;
+    }
+
+    size_type reserved() const noexcept {
+        return reserved_;
+    }
+
+private:
+    std::byte* data_      = nullptr;
+    size_type  committed_ = 0u;
+    size_type  reserved_  = 0u;
+};
+
+} // namespace detail
+
+// A BlockAllocator that reserves the virtual memory of `block_count` blocks up front and commits
+// them on demand. The blocks are handed out in address order and have to be deallocated in reverse
+// order, like a Memory_arena does. The n-th block is thus always at the same address, so a block
+// that was given back and allocated again still has the same address. The blocks are freshly
+// committed pages, so they are filled with zeros.
+class [[nodiscard]] Virtual_block_allocator {
+public:
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using zeroed_blocks   = std::true_type;
+
+    // The block size is rounded up to a multiple of the page size.
+    Virtual_block_allocator(size_type block_size, size_type block_count);
+
+    ~Virtual_block_allocator();
+
+    Virtual_block_allocator(Virtual_block_allocator&& other) noexcept;
+
+    Virtual_block_allocator& operator=(Virtual_block_allocator&& other) noexcept;
+
+    Memory_block allocate_block();
+
+    void deallocate_block(Memory_block block) noexcept;
+
+    size_type block_size() const noexcept {
+        return block_size_;
+    }
+
+    size_type capacity_left() const noexcept {
+        return size_type(end_ - current_) / block_size_;
+    }
+
+private:
+    std::byte* begin_;
+    std::byte* current_;
+    std::byte* end_;
+    size_type  block_size_;
+};
+
+// A BlockAllocator that places its blocks on the NUMA node of the calling thread. It reserves the
+// virtual memory of `block_count` blocks per node up front and commits them on demand, like a
+// Virtual_block_allocator per node. The cache of a Memory_arena keeps the blocks of each node
+// apart, so the pools of pinned worker threads keep their memory local.
+// NOTE:
+//  * The blocks have to be deallocated in reverse order, like a Memory_arena does.
+//  * A node without blocks left allocates on the other nodes.
+//  * Nodes above `max_nodes` are not used, their threads allocate on the lower nodes.
+class [[nodiscard]] Numa_block_allocator {
+public:
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using zeroed_blocks   = std::true_type;
+
+    static constexpr size_type max_nodes = 8u;
+
+    // The block size is rounded up to a multiple of the page size.
+    Numa_block_allocator(size_type block_size, size_type block_count);
+
+    ~Numa_block_allocator();
+
+    Numa_block_allocator(Numa_block_allocator&& other) noexcept;
+
+    Numa_block_allocator& operator=(Numa_block_allocator&& other) noexcept;
+
+    Memory_block allocate_block();
+
+    void deallocate_block(Memory_block block) noexcept;
+
+    size_type block_size() const noexcept {
+        return block_size_;
+    }
+
+    size_type node_count() const noexcept {
+        return node_count_;
+    }
+
+    // The node the calling thread allocates blocks on.
+    size_type current_node() const noexcept {
+        return numa_current_node() % node_count_;
+    }
+
+    // The node the block was allocated on, it works for any address inside of the block.
+    size_type node_of(Memory_block block) const noexcept {
+        return size_type(static_cast<std::byte*>(block.memory) - begin_) / node_size_;
+    }
+
+private:
+    std::byte* begin_;
+    size_type  block_size_;
+    size_type  node_size_;
+    size_type  node_count_;
+    std::byte* current_[max_nodes]{};
+};
+
+} // namespace salt
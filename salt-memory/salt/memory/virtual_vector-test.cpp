@@ -0,0 +1,48 @@
+#include <catch2/catch.hpp>
+
+#include <salt/memory/virtual_vector.hpp>
+
+#include <string>
+
+using namespace salt;
+
+TEST_CASE("salt::Virtual_vector", "[salt-memory/virtual_vector.hpp]") {
+    auto const page_size = virtual_memory_page_size();
+
+    Virtual_vector<std::size_t> vector{1u << 20u};
+    REQUIRE(vector.empty());
+    REQUIRE(vector.capacity() == 0u);
+    REQUIRE(vector.max_size() == (1u << 20u));
+
+    vector.push_back(0u);
+    REQUIRE(vector.capacity() == page_size / sizeof(std::size_t));
+
+    // The elements never move when the vector grows.
+    auto const first = &vector.front();
+    for (std::size_t i = 1u; i != 10000u; ++i)
+        vector.push_back(i);
+    REQUIRE(&vector.front() == first);
+    REQUIRE(vector.size() == 10000u);
+    REQUIRE(vector.back() == 9999u);
+    for (std::size_t i = 0u; i != vector.size(); ++i)
+        REQUIRE(vector[i] == i);
+
+    vector.resize(10u);
+    vector.shrink_to_fit();
+    REQUIRE(vector.capacity() == page_size / sizeof(std::size_t));
+    REQUIRE(std::span<std::size_t const>{vector}.size() == 10u);
+
+    auto moved = std::move(vector);
+    REQUIRE(vector.empty());
+    REQUIRE(moved.data() == first);
+    REQUIRE(moved.size() == 10u);
+
+    SECTION("maximum size") {
+        Virtual_vector<std::string> strings{page_size / sizeof(std::string)};
+        strings.resize(strings.max_size());
+        REQUIRE_THROWS_AS(strings.emplace_back("full"), std::bad_alloc);
+        strings.pop_back();
+        strings.emplace_back("last");
+        REQUIRE(strings.back() == "last");
+    }
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include <salt/memory/virtual_memory.hpp>
+
+#include <salt/config.hpp>
+#include <salt/foundation/logger.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace salt {
+
+// A vector that reserves the address range for its maximum size up front and commits pages as it
+// grows. The elements are never moved, so pointers and references to them stay valid until they
+// are erased, and growing costs only the commit of the new pages.
+// NOTE:
+//  * The maximum size is fixed at construction, growing beyond it throws std::bad_alloc.
+//  * Only the address range is reserved, a large maximum size does not use physical memory.
+template <typename T> class [[nodiscard]] Virtual_vector {
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = T const&;
+    using pointer         = T*;
+    using const_pointer   = T const*;
+    using iterator        = T*;
+    using const_iterator  = T const*;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Virtual_vector doesn't support over-aligned types");
+
+    Virtual_vector() noexcept = default;
+
+    explicit Virtual_vector(size_type max_size) : buffer_{max_size * sizeof(T)} {}
+
+    ~Virtual_vector() {
+        clear();
+    }
+
+    Virtual_vector(Virtual_vector&& other) noexcept
+            : buffer_{std::move(other.buffer_)}, size_{std::exchange(other.size_, 0u)} {}
+
+    Virtual_vector& operator=(Virtual_vector&& other) noexcept {
+        clear();
+        buffer_ = std::move(other.buffer_);
+        size_   = std::exchange(other.size_, 0u);
+        return *this;
+    }
+
+    // Commits the memory of at least `capacity` elements.
+    void reserve(size_type capacity) {
+        buffer_.commit(capacity * sizeof(T));
+    }
+
+    // Decommits the pages that hold no elements.
+    void shrink_to_fit() noexcept {
+        buffer_.decommit(size_ * sizeof(T));
+    }
+
+    template <typename... Args> T& emplace_back(Args&&... args) {
+        if (size_ == capacity()) [[unlikely]]
+            grow();
+        auto& result = *std::ranges::construct_at(data() + size_, std::forward<Args>(args)...);
+        ++size_;
+        return result;
+    }
+
+    void push_back(T const& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        SALT_ASSERT(size_ != 0u);
+        std::destroy_at(data() + --size_);
+    }
+
+    void resize(size_type size) {
+        if (size < size_) {
+            std::destroy(data() + size, data() + size_);
+            size_ = size;
+            return;
+        }
+
+        reserve(size);
+        for (; size_ != size; ++size_)
+            std::ranges::construct_at(data() + size_);
+    }
+
+    void clear() noexcept {
+        std::destroy(data(), data() + size_);
+        size_ = 0u;
+    }
+
+    T& operator[](size_type index) noexcept {
+        SALT_ASSERT(index < size_);
+        return data()[index];
+    }
+
+    T const& operator[](size_type index) const noexcept {
+        SALT_ASSERT(index < size_);
+        return data()[index];
+    }
+
+    T& front() noexcept {
+        return (*this)[0u];
+    }
+
+    T const& front() const noexcept {
+        return (*this)[0u];
+    }
+
+    T& back() noexcept {
+        return (*this)[size_ - 1u];
+    }
+
+    T const& back() const noexcept {
+        return (*this)[size_ - 1u];
+    }
+
+    T* data() noexcept {
+        return reinterpret_cast<T*>(buffer_.data());
+    }
+
+    T const* data() const noexcept {
+        return reinterpret_cast<T const*>(buffer_.data());
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+
+    iterator end() noexcept {
+        return data() + size_;
+    }
+
+    const_iterator begin() const noexcept {
+        return data();
+    }
+
+    const_iterator end() const noexcept {
+        return data() + size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0u;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    // The number of elements that fit into the committed memory.
+    size_type capacity() const noexcept {
+        return buffer_.committed() / sizeof(T);
+    }
+
+    size_type max_size() const noexcept {
+        return buffer_.reserved() / sizeof(T);
+    }
+
+    operator std::span<T>() noexcept {
+        return {data(), size_};
+    }
+
+    operator std::span<T const>() const noexcept {
+        return {data(), size_};
+    }
+
+private:
+    // Doubles the committed memory, so a sequence of insertions commits only log(n) times.
+    void grow() {
+        if (size_ == max_size()) [[unlikely]]
+            throw std::bad_alloc();
+        reserve(std::min(std::max(2u * capacity(), size_ + 1u), max_size()));
+    }
+
+    detail::Virtual_buffer buffer_;
+    size_type              size_ = 0u;
+};
+
+} // namespace salt